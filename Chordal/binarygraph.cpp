@@ -0,0 +1,93 @@
+#include "binarygraph.h"
+#include <limits.h>
+
+BinaryGraphHeader BinaryGraphFile::MakeHeader(string method, const vector<double>& params) {
+	BinaryGraphHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header._magic, BINARY_GRAPH_MAGIC, sizeof(header._magic));
+	header._version = BINARY_GRAPH_VERSION;
+	header._byteOrder = BINARY_GRAPH_BYTE_ORDER;
+	header._headerSize = sizeof(BinaryGraphHeader);
+	strncpy(header._method, method.c_str(), sizeof(header._method) - 1);
+	for (int i = 0; i < 4; ++i)
+		header._params[i] = i < (int) params.size() ? params[i] : -1;
+	return header;
+}
+
+/*
+ * three sequential writes: the header and the two arrays of the graph as they are in memory
+ */
+bool BinaryGraphFile::Write(string fileName, const CSRGraph& g, BinaryGraphHeader header) {
+	header._numNodes = g.GetNumNodes();
+	header._numEdges = g.GetNumEdges();
+	ofstream file(fileName, ios::out | ios::binary);
+	if (!file) {
+		cout << "Cannot open " << fileName << " for writing!" << endl;
+		return false;
+	}
+	file.write((const char*) &header, sizeof(header));
+	file.write((const char*) g.GetOffsets().data(), g.GetOffsets().size() * sizeof(int64_t));
+	file.write((const char*) g.GetNeighbours().data(), g.GetNeighbours().size() * sizeof(int));
+	file.close();
+	if (!file) {
+		cout << "Cannot write " << fileName << "!" << endl;
+		return false;
+	}
+	return true;
+}
+
+bool BinaryGraphFile::Open(string fileName) {
+	Close();
+	if (!_file.Open(fileName)) return false;
+	if (!Validate(fileName)) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool BinaryGraphFile::Validate(string fileName) {
+	const char* data = _file.GetData();
+	size_t size = _file.GetSize();
+	_header = (const BinaryGraphHeader*) data;
+	if (size < sizeof(BinaryGraphHeader) || memcmp(_header->_magic, BINARY_GRAPH_MAGIC, sizeof(_header->_magic)) != 0) {
+		cout << fileName << " is not a binary graph file!" << endl;
+		return false;
+	}
+	if (_header->_version != BINARY_GRAPH_VERSION) {
+		cout << fileName << " has version " << _header->_version << ", only version " << BINARY_GRAPH_VERSION << " can be read!" << endl;
+		return false;
+	}
+	if (_header->_byteOrder != BINARY_GRAPH_BYTE_ORDER) {
+		cout << fileName << " was written on a machine of another byte order!" << endl;
+		return false;
+	}
+	int64_t numNodes = _header->_numNodes, numEdges = _header->_numEdges;
+	uint64_t headerSize = _header->_headerSize;
+	// numNodes is bounded first, so the bytes before the neighbours cannot overflow, and numEdges by the bytes left after them
+	if (numNodes < 0 || numNodes > INT_MAX || numEdges < 0 || headerSize < sizeof(BinaryGraphHeader) || headerSize % sizeof(int64_t) != 0
+		|| size < headerSize + (numNodes + 1) * sizeof(int64_t)
+		|| (uint64_t) numEdges > (size - headerSize - (numNodes + 1) * sizeof(int64_t)) / (2 * sizeof(int))) {
+		cout << fileName << " is truncated or corrupt!" << endl;
+		return false;
+	}
+	_offsets = (const int64_t*) (data + _header->_headerSize);
+	_neighbours = (const int*) (_offsets + numNodes + 1);
+	bool valid = _offsets[0] == 0 && _offsets[numNodes] == 2 * numEdges;
+	for (int64_t v = 0; v < numNodes && valid; ++v)
+		valid = _offsets[v] <= _offsets[v + 1];
+	for (int64_t k = 0; k < 2 * numEdges && valid; ++k)
+		valid = _neighbours[k] >= 0 && _neighbours[k] < numNodes;
+	if (!valid) {
+		cout << fileName << " is truncated or corrupt!" << endl;
+		return false;
+	}
+	return true;
+}
+
+void BinaryGraphFile::Close() {
+	_file.Close();
+	_header = NULL;
+	_offsets = NULL;
+	_neighbours = NULL;
+}
@@ -0,0 +1,56 @@
+#ifndef BINARYGRAPH_H_
+#define BINARYGRAPH_H_
+
+#include "common.h"
+#include "csrgraph.h"
+#include "mappedfile.h"
+#include <stdint.h>
+
+#define BINARY_GRAPH_MAGIC "CHRDCSR"         //7 characters and the terminating zero
+#define BINARY_GRAPH_VERSION 1
+#define BINARY_GRAPH_BYTE_ORDER 0x01020304u  //read back as another value on a machine of the other byte order
+
+/*
+ * the file is this header, then the (numNodes+1) offsets as int64 and the 2*numEdges neighbours as int32, all in the byte
+ * order of the writing machine; the arrays are the ones of CSRGraph, so the neighbours of node u are
+ * neighbours[offsets[u]] ... neighbours[offsets[u+1]-1] in ascending order
+ */
+struct BinaryGraphHeader {
+	char _magic[8];
+	uint32_t _version;
+	uint32_t _byteOrder;
+	uint32_t _headerSize;                   //bytes before the offsets
+	uint32_t _reserved;
+	int64_t _numNodes;
+	int64_t _numEdges;
+	char _method[8];                        //gs, cn, pt or peo
+	double _params[4];                      //method-specific params in the order of the command line, -1 if unused
+};
+
+/*
+ * a binary graph file mapped into memory: the arrays are used in place, without parsing or copying
+ */
+class BinaryGraphFile {
+public:
+	BinaryGraphFile() : _header(NULL), _offsets(NULL), _neighbours(NULL) {}
+	static BinaryGraphHeader MakeHeader(string method, const vector<double>& params);
+	static bool Write(string fileName, const CSRGraph& g, BinaryGraphHeader header);
+	bool Open(string fileName);
+	void Close();
+	const BinaryGraphHeader& GetHeader() const { return *_header; }
+	int GetNumNodes() const { return int(_header->_numNodes); }
+	long long GetNumEdges() const { return _header->_numEdges; }
+	int GetDegree(int u) const { return int(_offsets[u + 1] - _offsets[u]); }
+	const int* NeighboursBegin(int u) const { return _neighbours + _offsets[u]; }
+	const int* NeighboursEnd(int u) const { return _neighbours + _offsets[u + 1]; }
+	void CopyTo(CSRGraph& g) const { g.Assign(GetNumNodes(), GetNumEdges(), (const long long*) _offsets, _neighbours); }
+
+private:
+	MappedFile _file;
+	const BinaryGraphHeader* _header;
+	const int64_t* _offsets;
+	const int* _neighbours;
+	bool Validate(string fileName);
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef BITOPS_H_
+#define BITOPS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+inline int PopCount(uint64_t word) {
+#ifdef _MSC_VER
+	return (int) __popcnt64(word);
+#else
+	return __builtin_popcountll(word);
+#endif
+}
+
+/*
+ * index of the lowest set bit, word should not be zero
+ */
+inline int LowestBitIndex(uint64_t word) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return (int) index;
+#else
+	return __builtin_ctzll(word);
+#endif
+}
+
+/*
+ * returns true if the two bit arrays (numWords 64-bit words each) have a common set bit
+ * the vector loops are compiled in when the target supports AVX-512 or AVX2, the scalar loop handles the rest
+ */
+inline bool BitsIntersect(const uint64_t* a, const uint64_t* b, size_t numWords) {
+	size_t i = 0;
+#if defined(__AVX512F__)
+	for (; i + 8 <= numWords; i += 8) {
+		__m512i x = _mm512_loadu_si512((const void*)(a + i));
+		__m512i y = _mm512_loadu_si512((const void*)(b + i));
+		if (_mm512_test_epi64_mask(x, y)) return true;
+	}
+#elif defined(__AVX2__)
+	for (; i + 4 <= numWords; i += 4) {
+		__m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+		__m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+		if (!_mm256_testz_si256(x, y)) return true;
+	}
+#endif
+	for (; i < numWords; ++i) {
+		if (a[i] & b[i]) return true;
+	}
+	return false;
+}
+
+/*
+ * dst |= src over numWords 64-bit words
+ */
+inline void BitsOr(uint64_t* dst, const uint64_t* src, size_t numWords) {
+	size_t i = 0;
+#if defined(__AVX512F__)
+	for (; i + 8 <= numWords; i += 8) {
+		__m512i x = _mm512_loadu_si512((const void*)(dst + i));
+		__m512i y = _mm512_loadu_si512((const void*)(src + i));
+		_mm512_storeu_si512((void*)(dst + i), _mm512_or_si512(x, y));
+	}
+#elif defined(__AVX2__)
+	for (; i + 4 <= numWords; i += 4) {
+		__m256i x = _mm256_loadu_si256((const __m256i*)(dst + i));
+		__m256i y = _mm256_loadu_si256((const __m256i*)(src + i));
+		_mm256_storeu_si256((__m256i*)(dst + i), _mm256_or_si256(x, y));
+	}
+#endif
+	for (; i < numWords; ++i)
+		dst[i] |= src[i];
+}
+
+#endif
@@ -1,226 +1,855 @@
-#include "chordal.h"
-#include "tree.h"
-#include "stats.h"
-
-
-ChordalGraph::ChordalGraph(ChordalGenerationParams params) :_peoBased(*this), _subtreeIntersection(*this) {
-	_method = params._method;
-	_numNodes = params._numNodes;
-	_maxSubtreeSize = params._maxSubtreeSize;
-	_thresholdProb = params._thresholdProb;
-	_edgeDelPerc = params._edgeDelPerc;
-	_barrier = params._barrier;
-	_upperBoundCoef = params._upperBoundCoef;
-	_timeToBuild = 0;
-}
-
-void ChordalGraph::Build() {
-	clock_t begin = clock();
-	if (_method == "peo") {
-		_peoBased.Build();
-	} else {
-		_subtreeIntersection.Build();
-	}
-	clock_t end = clock();
-	_timeToBuild = double(GetTimeUsage(end, begin)) / 1000;
-}
-
-void ChordalGraph::CollectAndWriteStats(string fileName, string instanceInfoCSVFileName, string cliqueSizeInfoCSVFileName) {
-
-	Stats* stats;
-	stats = new Stats(*this);
-	stats->CalculateStats();
-
-	ofstream file;
-	file.open(instanceInfoCSVFileName, ios::out | ios::ate | ios::app);
-	file << fileName << ",";
-
-	string methodName;
-	if (_method == "gs") {
-		methodName = "growingSubtree";
-		file << methodName << "," << _maxSubtreeSize << ",";
-	} else if (_method == "cn") {
-		methodName = "connectingNodes";
-		file << methodName << "," << _thresholdProb << ",";
-	} else if (_method == "pt") {
-		methodName = "prunedTree";
-		file << methodName << "," << _edgeDelPerc << "," << _barrier << ",";
-	} else if (_method == "peo") {
-		methodName = "peoBased";
-		file << methodName << "," << _upperBoundCoef << ",";
-	}
-
-	file << stats->GetNumNodes() << "," << stats->GetDensity() << "," << stats->GetNumEdges() << "," << stats->GetNumConnComps() << ","
-			<< stats->GetNumMaximalCliques() << "," << stats->GetMaxSize() << "," << stats->GetMinSize() << "," << stats->GetAvgSize() << ","
-			<< stats->GetStdev() << "," << _timeToBuild << endl;
-	file.close();
-
-
-	cout << "A chordal graph with " << _numNodes << " nodes and " << stats->GetDensity() << " density is produced." << endl;
-
-	const vector<int>& cliqueSizeFreqs = stats->GetCliqueSizeFreqs();
-	ofstream file2;
-	file2.open(cliqueSizeInfoCSVFileName, ios::out | ios::ate | ios::app);
-	file2 << fileName << ",";
-	for (unsigned int i = 1; i < cliqueSizeFreqs.size(); ++i) //0th entry is not needed because the indices correspond to clique sizes
-		file2 << cliqueSizeFreqs.at(i) << ",";
-	file2 << endl;
-	file2.close();
-
-	delete stats;
-}
-
-void ChordalGraph::SubtreeIntersection::Build() {
-	if (_chg._method == "gs") {
-		BuildwithGrowingSubtree();
-	} else if (_chg._method == "cn") {
-		BuildwithConnectingNodes();
-	} else if (_chg._method == "pt") {
-		BuildwithPrunedTree();
-	}
-}
-
-bool ChordalGraph::SubtreeIntersection::CheckIntersection(const vector<set<int>>& subtrees, int subtree1Index, int subtree2Index) {
-	for (setIterator it1 = subtrees.at(subtree1Index).begin(); it1 != subtrees.at(subtree1Index).end(); ++it1) {
-		if (subtrees.at(subtree2Index).find(*it1) != subtrees.at(subtree2Index).end()) //then they intersect
-			return true;
-	}
-	return false;
-}
-
-void ChordalGraph::SubtreeIntersection::ConstructIntersectionGraph(const vector<set<int>>& subtrees) {
-	//_g is an empty graph to be filled
-	int numIntersections = 0;
-	for (unsigned int i = 0; i < subtrees.size(); ++i) _chg._g.addNode();
-	for (unsigned int i = 0; i < subtrees.size() - 1; ++i) {
-		for (unsigned int j = i + 1; j < subtrees.size(); ++j) {
-			if (CheckIntersection(subtrees, i, j)) {
-				_chg._g.addEdge(_chg._g.nodeFromId(i), _chg._g.nodeFromId(j));
-				numIntersections++;
-			}
-		}
-	}
-}
-
-void ChordalGraph::SubtreeIntersection::BuildwithGrowingSubtree() {
-	Tree tr(_chg._numNodes);
-	tr.BuildRandomTree();
-	for (int i = 0; i < _chg._numNodes; ++i) {
-		uniform_int_distribution<int>  selector(1, _chg._maxSubtreeSize);
-		int subtreeSize = selector(generator);
-		tr.FindAndAddGrowingSubtree(subtreeSize);
-	}
-	ConstructIntersectionGraph(tr._subtreesS);
-}
-
-void ChordalGraph::SubtreeIntersection::BuildwithConnectingNodes() {
-	Tree tr(_chg._numNodes);
-	tr.BuildRandomTree();
-	vector<int> allNodeIDs;
-	for (int i = 0; i < _chg._numNodes; ++i)
-		allNodeIDs.push_back(i);
-	double lambda = _chg._thresholdProb*_chg._numNodes;
-	for (int i = 0; i < _chg._numNodes; ++i) {
-		std::poisson_distribution<int> selector(lambda);
-		int numNodesToConnect = selector(generator);
-		if (numNodesToConnect < 0.5) {
-			numNodesToConnect = 1;
-		} else if (numNodesToConnect > _chg._numNodes + 0.1) {
-			numNodesToConnect = _chg._numNodes;
-		}
-		tr.FindAndAddSubtreeByConnNodes(numNodesToConnect, allNodeIDs);
-	}
-	ConstructIntersectionGraph(tr._subtreesS);
-}
-
-void ChordalGraph::SubtreeIntersection::BuildwithPrunedTree() {
-	Tree tr(_chg._numNodes);
-	tr.BuildRandomTree();
-	for (int i = 0; i < _chg._numNodes; ++i) {
-		tr.FindAndAddSubtreeWithEdgeDeletion(_chg._edgeDelPerc, _chg._barrier);
-	}
-	ConstructIntersectionGraph(tr._subtreesS);
-}
-
-
-
-void ChordalGraph::PEOBasedConstruction::Build() {
-	BuildPEOBased();
-}
-
-void ChordalGraph::PEOBasedConstruction::BuildPEOBased()
-{
-	_adjList.resize(_chg._numNodes);
-
-	int lowerBound = 1;
-	for (int i = 0; i < _chg._numNodes - 1; ++i) {
-		int upperBound = ceil((_chg._numNodes - i - 1)*_chg._upperBoundCoef);
-		uniform_int_distribution<int> neighCount(lowerBound, upperBound);
-		int numNeighbours = neighCount(generator);
-		if (numNeighbours < _chg._numNodes - i - 1) { // if there is room for random selection, then do it
-			set<int> neighbourhood;
-			neighbourhood.insert(i); //neighbourhood includes the node itself
-			AssignSuccesiveNeighbours(neighbourhood, numNeighbours, i);
-			FindFormerSuccessiveNeighbours(i, neighbourhood);
-			MakeNeighbourhoodClique(neighbourhood);
-		} else {
-			MakeTheRestClique(i);
-			break;
-		}
-	}
-	ConvertToLemonObject();
-}
-
-void ChordalGraph::PEOBasedConstruction::AssignSuccesiveNeighbours(set<int>& neighbourhood, int numNeighbours, int nodeID) {
-	while ((int) neighbourhood.size() < numNeighbours + 1) {
-		uniform_int_distribution<int> neighPlaces(nodeID + 1, _chg._numNodes - 1);
-		int neighbourID = neighPlaces(generator);
-		neighbourhood.insert(neighbourID);
-	}
-}
-
-void ChordalGraph::PEOBasedConstruction::FindFormerSuccessiveNeighbours(int nodeID, set<int>& neighbours) {
-	setIterator it = _adjList.at(nodeID).lower_bound(nodeID + 1);
-	for (; it != _adjList.at(nodeID).end(); ++it) {
-		neighbours.insert(*it);
-	}
-}
-
-void ChordalGraph::PEOBasedConstruction::MakeNeighbourhoodClique(const set<int>& neighbourhood) {
-	int edgeCounter = 0;
-	for (setIterator i = neighbourhood.begin(); i != neighbourhood.end(); ++i) {
-		for (setIterator j = neighbourhood.begin(); j != neighbourhood.end(); ++j) {
-			if ((*i) != (*j)) { //no self-loops allowed
-				if (_adjList.at(*i).insert(*j).second) edgeCounter++;
-			}
-		}
-	}
-	edgeCounter = edgeCounter / 2; //since each edge is counted twice above
-	_numEdges += edgeCounter;
-}
-
-void ChordalGraph::PEOBasedConstruction::MakeTheRestClique(int nodeID) {
-	int edgeCounter = 0;
-	for (int i = nodeID; i < _chg._numNodes; ++i) {
-		for (int j = nodeID; j < _chg._numNodes; ++j) {
-			if (i != j) {
-				if (_adjList.at(i).insert(j).second) edgeCounter++;
-			}
-		}
-	}
-	edgeCounter = edgeCounter / 2; //since each edge is counted twice above
-	_numEdges += edgeCounter;
-}
-
-void ChordalGraph::PEOBasedConstruction::ConvertToLemonObject()
-{
-	for (int i = 0; i < _chg._numNodes; ++i) _chg._g.addNode();
-	for (int i = 0; i < _chg._numNodes - 1; ++i) {
-		Node u = _chg._g.nodeFromId(i);
-		setIterator it = _adjList.at(i).lower_bound(i + 1);
-		for (; it != _adjList.at(i).end(); ++it) {
-			Node v = _chg._g.nodeFromId(*it);
-			_chg._g.addEdge(u, v);
-		}
-	}
-}
+#include "chordal.h"
+#include "tree.h"
+#include "stats.h"
+#include "bitops.h"
+#include "binarygraph.h"
+#include "intersectionmodel.h"
+
+#define BITSET_WORDS_PER_PROBE 8            //64-bit words AND-ed in about the time of one probe of the node index (auto mode)
+#define MAX_BITSET_BYTES 2147483648LL       //the bitset mode is never selected automatically above this memory
+#define CHUNKS_PER_THREAD 64                //rows of the intersection loop are split into this many chunks per worker thread
+#define MAX_PENDING_CHUNKS_PER_THREAD 4     //chunks a worker thread may finish ahead of the emitted ones
+#define CALIBRATION_SAMPLE_SIZE 4000        //subtrees drawn on the full host tree for a density estimate of gs, cn and pt
+#define CALIBRATION_PT_SAMPLE_DIVISOR 64    //pt samples at most n/64 subtrees of O(n) each, so its steps cost about a quarter of the build
+#define CALIBRATION_PT_MIN_SAMPLE 100
+#define CALIBRATION_PILOT_NODES 1000        //n of the pilot runs of peo
+#define CALIBRATION_MAX_STEPS 16
+#define CALIBRATION_TOLERANCE 0.02          //relative error of the estimated density at which the calibration stops
+
+
+ChordalGraph::ChordalGraph(ChordalGenerationParams params) :_peoBased(*this), _subtreeIntersection(*this) {
+	_method = params._method;
+	_numNodes = params._numNodes;
+	_maxSubtreeSize = params._maxSubtreeSize;
+	_thresholdProb = params._thresholdProb;
+	_edgeDelPerc = params._edgeDelPerc;
+	_barrier = params._barrier;
+	_upperBoundCoef = params._upperBoundCoef;
+	_intersectionMode = params._intersectionMode;
+	_numThreads = params._numThreads;
+	_peoAdjacency = params._peoAdjacency;
+	_rng.Seed(params._seed, params._stream);
+	_timeToBuild = 0;
+	_streamed = false;
+	_model = NULL;
+	_modelOnly = false;
+	_pilotDensity = -1;
+}
+
+ChordalGraph::~ChordalGraph() {
+	delete _model;
+}
+
+void ChordalGraph::Build() {
+	GraphBuilderSink builder(_g);
+	TimePoint begin = chrono::steady_clock::now();
+	if (_method == "peo") {
+		ScopedTimer timer(_times, PHASE_EDGES);
+		_peoBased.Build(builder, _rng);
+	} else {
+		_subtreeIntersection.Build(builder, _rng);
+	}
+	_timeToBuild = ScopedTimer::SecondsSince(begin);
+	_streamed = false;
+}
+
+/*
+ * the edges go to the sink as they are generated and only their counts are kept
+ */
+void ChordalGraph::Build(EdgeSink& sink) {
+	TeeSink tee(sink, _counts);
+	TimePoint begin = chrono::steady_clock::now();
+	if (_method == "peo") {
+		ScopedTimer timer(_times, PHASE_EDGES);
+		_peoBased.Build(tee, _rng);
+	} else {
+		_subtreeIntersection.Build(tee, _rng);
+	}
+	_timeToBuild = ScopedTimer::SecondsSince(begin);
+	_streamed = true;
+}
+
+/*
+ * only the host tree and the subtrees of gs, cn or pt, whose intersection graph is the generated graph; its edges are neither
+ * constructed nor stored
+ */
+void ChordalGraph::BuildModel() {
+	TimePoint begin = chrono::steady_clock::now();
+	_subtreeIntersection.BuildModel(_rng);
+	_timeToBuild = ScopedTimer::SecondsSince(begin);
+	_modelOnly = true;
+}
+
+/*
+ * the method-specific params in the order of the command line
+ */
+vector<double> ChordalGraph::GetMethodParams() const {
+	vector<double> params;
+	if (_method == "gs") {
+		params.push_back(_maxSubtreeSize);
+	} else if (_method == "cn") {
+		params.push_back(_thresholdProb);
+	} else if (_method == "pt") {
+		params.push_back(_edgeDelPerc);
+		params.push_back(_barrier);
+	} else if (_method == "peo") {
+		params.push_back(_upperBoundCoef);
+	}
+	return params;
+}
+
+long long ChordalGraph::GetNumEdges() const {
+	return _modelOnly ? _model->CountIntersectionEdges() : _streamed ? _counts.GetNumEdges() : _g.GetNumEdges();
+}
+
+bool ChordalGraph::WriteGraphToFile(string fileName) {
+	ScopedTimer timer(_times, PHASE_WRITE);
+	return _g.WriteLGF(fileName);
+}
+
+bool ChordalGraph::WriteBinaryGraphToFile(string fileName) {
+	ScopedTimer timer(_times, PHASE_WRITE);
+	return BinaryGraphFile::Write(fileName, _g, BinaryGraphFile::MakeHeader(_method, GetMethodParams()));
+}
+
+bool ChordalGraph::WriteModelToFile(string fileName) {
+	ScopedTimer timer(_times, PHASE_WRITE);
+	return IntersectionModel::Write(fileName, *_model, _method, GetMethodParams());
+}
+
+/*
+ * sets the param of the method (max_subtree_size of gs, node_sel_prob_param of cn, edge_deletion_perc of pt, upper_bound_coef of
+ * peo) so that the density is about targetDensity, by bisection on density estimates, which all draw the same random numbers
+ * (from a copy of the stream of the instance), so they change monotonically with the param. The estimates of gs, cn and pt
+ * are the exact densities of samples of CALIBRATION_SAMPLE_SIZE subtrees (see BuildSample), without the edges; those of peo
+ * come from pilot runs at CALIBRATION_PILOT_NODES nodes, since its density stays about the same when n * upper_bound_coef does.
+ * Returns the estimated density
+ */
+double ChordalGraph::CalibrateDensity(double targetDensity) {
+	if (_numNodes < 2) return 0;
+	TimePoint begin = chrono::steady_clock::now();
+	int numNodes = _method == "peo" ? min(_numNodes, CALIBRATION_PILOT_NODES) : _numNodes;
+	double low, high;                   //the param, or its logarithm for gs, cn and peo, is searched in [low, high]
+	bool increasing = true;             //the density increases with the param
+	if (_method == "gs") {
+		low = 0;
+		high = log(_numNodes);
+	} else if (_method == "cn") {
+		low = log(0.1 / _numNodes);     //a tenth of a node connected on average
+		high = 0;
+	} else if (_method == "pt") {
+		low = 0;
+		high = 0.999;
+		increasing = false;
+	} else {
+		low = log(0.5 / numNodes);      //a tree
+		high = 0;
+	}
+	auto setParam = [&](double x) {
+		if (_method == "gs") _maxSubtreeSize = (int) llround(exp(x));
+		else if (_method == "cn") _thresholdProb = exp(x);
+		else if (_method == "pt") _edgeDelPerc = x;
+		else _upperBoundCoef = exp(x);
+	};
+	double bestParam = low, bestDensity = -1;
+	for (int step = 0; step < CALIBRATION_MAX_STEPS; ++step) {
+		double x = (low + high) / 2;
+		setParam(x);
+		double density = EstimateDensity(numNodes);
+		if (bestDensity < 0 || fabs(density - targetDensity) < fabs(bestDensity - targetDensity)) {
+			bestParam = x;
+			bestDensity = density;
+		}
+		if (fabs(density - targetDensity) <= CALIBRATION_TOLERANCE * targetDensity) break;
+		if (_method == "gs" && llround(exp(high)) - llround(exp(low)) <= 1) break;
+		if ((density < targetDensity) == increasing) low = x;
+		else high = x;
+	}
+	setParam(bestParam);
+	if (_method == "peo") _upperBoundCoef = min(1.0, _upperBoundCoef * numNodes / _numNodes);
+	delete _model;
+	_model = NULL;
+	_pilotDensity = -1;
+	_times.Reset();
+
+	cout << "Calibrated the param to " << GetMethodParams()[0] << " (estimated density: " << bestDensity << ") in "
+		<< ScopedTimer::SecondsSince(begin) << " s." << endl;
+	return bestDensity;
+}
+
+/*
+ * the density of a sample of the subtrees for gs, cn and pt, or of a pilot run at numNodes nodes for peo, with the current params
+ */
+double ChordalGraph::EstimateDensity(int numNodes) {
+	RandomEngine rng = _rng;
+	if (_method == "peo")
+		return RunPEOPilot(numNodes, _upperBoundCoef, rng());
+	int numSubtrees = min(_numNodes, CALIBRATION_SAMPLE_SIZE);
+	if (_method == "pt")
+		numSubtrees = min(numSubtrees, max(CALIBRATION_PT_MIN_SAMPLE, _numNodes / CALIBRATION_PT_SAMPLE_DIVISOR));
+	_subtreeIntersection.BuildSample(rng, numSubtrees);
+	return _model->CountIntersectionEdges() / (double(numSubtrees)*(numSubtrees - 1) / 2);
+}
+
+/*
+ * the density of a peo graph of numNodes nodes, only counted; a pilot always uses the bit matrix, which is fast at any density
+ * for the small n of the pilots (and does not select its adjacency by a pilot of its own)
+ */
+double ChordalGraph::RunPEOPilot(int numNodes, double upperBoundCoef, uint64_t seed) {
+	if (numNodes < 2) return 0;
+	ChordalGenerationParams params("peo");
+	params._numNodes = numNodes;
+	params._upperBoundCoef = upperBoundCoef;
+	params._peoAdjacency = "bitmatrix";
+	params._seed = seed;
+	ChordalGraph pilot(params);
+	CountingSink counts;
+	pilot.Build(counts);
+	return pilot.GetNumEdges() / (double(numNodes)*(numNodes - 1) / 2);
+}
+
+/*
+ * the density of peo from a pilot run at CALIBRATION_PILOT_NODES nodes with the same n * upper_bound_coef (see CalibrateDensity),
+ * on a copy of the random stream; the pilot is run once and its density kept for the selection of the adjacency and the estimates
+ */
+double ChordalGraph::EstimatePEODensity() {
+	if (_pilotDensity < 0) {
+		RandomEngine rng = _rng;
+		int numPilotNodes = min(_numNodes, CALIBRATION_PILOT_NODES);
+		_pilotDensity = RunPEOPilot(numPilotNodes, min(1.0, _upperBoundCoef * _numNodes / numPilotNodes), rng());
+	}
+	return _pilotDensity;
+}
+
+/*
+ * the number of edges without generating them. It is exact for gs, cn and pt, from the coverage counts of the subtrees, so only
+ * the model is built. For peo, lowerBound is the sum of a draw of the numbers of successors (each node adds at least that many
+ * edges, to distinct successors), and the estimate is the density of a pilot run at CALIBRATION_PILOT_NODES nodes, which stays
+ * about the same when n * upper_bound_coef does (see CalibrateDensity); most edges of a sparse peo graph are the fill-in
+ */
+long long ChordalGraph::EstimateNumEdges(long long& lowerBound) {
+	if (_method != "peo") {
+		BuildModel();
+		lowerBound = _model->CountIntersectionEdges();
+		return lowerBound;
+	}
+	TimePoint begin = chrono::steady_clock::now();
+	RandomEngine rng = _rng;
+	lowerBound = _peoBased.DrawNumSuccessors(rng);
+	if (_numNodes < 2) return 0;
+	double pilotDensity = EstimatePEODensity();
+	_timeToBuild = ScopedTimer::SecondsSince(begin);
+	return max(lowerBound, llround(pilotDensity * (double(_numNodes)*(_numNodes - 1) / 2)));
+}
+
+/*
+ * bytes held at the peak of a build with numEdges edges: the construction (the subtrees and the index of the subtrees covering each
+ * host tree node, or the successors or the bit matrix of peo), and unless the edges are streamed, the edge buffer and the CSR graph
+ * built from it; the subtrees have to be built already (see EstimateNumEdges)
+ */
+double ChordalGraph::EstimateMemory(long long numEdges, bool streamed) {
+	double bytes;
+	if (_method == "peo") {
+		bytes = _peoBased.EstimateWorkspace(numEdges);
+	} else {
+		double totalSize = _model->_subtreesS.GetTotalSize();
+		bytes = 2 * (totalSize * sizeof(int) + (_numNodes + 1.0) * sizeof(long long));
+	}
+	if (!streamed)
+		bytes += numEdges * (sizeof(pair<int, int>) + 2.0 * sizeof(int)) + (_numNodes + 1.0) * sizeof(long long);
+	return bytes;
+}
+
+void ChordalGraph::CollectAndWriteStats(string fileName, string instanceInfoCSVFileName, string cliqueSizeInfoCSVFileName, string cliqueTreeFileName, bool* isChordal) {
+	ostringstream instanceInfo, cliqueSizeInfo;
+	double density = CollectStats(fileName, instanceInfo, cliqueSizeInfo, cliqueTreeFileName, isChordal);
+
+	ofstream file;
+	file.open(instanceInfoCSVFileName, ios::out | ios::ate | ios::app);
+	file << instanceInfo.str();
+	file.close();
+
+	cout << "A chordal graph with " << _numNodes << " nodes and " << density << " density is produced." << endl;
+
+	if (cliqueSizeInfo.str().empty()) return;
+	ofstream file2;
+	file2.open(cliqueSizeInfoCSVFileName, ios::out | ios::ate | ios::app);
+	file2 << cliqueSizeInfo.str();
+	file2.close();
+}
+
+/*
+ * writes the rows of the graph to the given streams instead of the csv files (nothing to cliqueSizeInfo for a streamed graph),
+ * and returns the density; the clique tree is written to cliqueTreeFileName unless it is empty, and the graph is checked for
+ * chordality (with the result in *isChordal) unless isChordal is NULL, both of which need the graph itself
+ */
+double ChordalGraph::CollectStats(string fileName, ostream& instanceInfo, ostream& cliqueSizeInfo, string cliqueTreeFileName, bool* isChordal) {
+
+	Stats* stats;
+	TimePoint begin = chrono::steady_clock::now();
+	if ((!cliqueTreeFileName.empty() || isChordal != NULL) && !_streamed && !_modelOnly) {
+		stats = new Stats(*this);
+		stats->CalculateStats(!cliqueTreeFileName.empty());
+		if (!cliqueTreeFileName.empty())
+			stats->WriteCliqueTree(cliqueTreeFileName);
+		if (isChordal != NULL) {
+			ostringstream report;
+			*isChordal = stats->VerifyPEO(report, fileName);
+			cout << report.str();
+		}
+	} else if (_model != NULL) {
+		stats = new Stats(*_model, GetNumEdges()); //the cliques follow from the subtrees
+	} else if (_streamed) {
+		stats = new Stats(_counts); //the edges are not stored, so only the counts are available
+	} else {
+		stats = new Stats(*this);
+		stats->CalculateStats();
+	}
+
+	_times.Add(PHASE_STATS, ScopedTimer::SecondsSince(begin));
+
+	ostringstream timeColumns;
+	timeColumns << _timeToBuild << "," << _times.Columns();
+	stats->WriteInstanceInfo(instanceInfo, fileName, Stats::MethodColumns(_method, GetMethodParams()), timeColumns.str());
+	if (stats->HasCliqueStats())
+		stats->WriteCliqueSizeFrequencies(cliqueSizeInfo, fileName);
+	double density = stats->GetDensity();
+
+	delete stats;
+	return density;
+}
+
+void ChordalGraph::SubtreeIntersection::Build(EdgeSink& sink, RandomEngine& rng) {
+	_sink = &sink;
+	_rng = &rng;
+	_numSubtrees = _chg._numNodes;
+	BuildWithMethod();
+}
+
+void ChordalGraph::SubtreeIntersection::BuildModel(RandomEngine& rng) {
+	_sink = NULL;
+	_rng = &rng;
+	_numSubtrees = _chg._numNodes;
+	BuildWithMethod();
+}
+
+/*
+ * the model with numSubtrees subtrees on the host tree of the full size instead of one per node; the subtrees are drawn
+ * independently, so the density of its intersection graph estimates the density of the graph
+ */
+void ChordalGraph::SubtreeIntersection::BuildSample(RandomEngine& rng, int numSubtrees) {
+	_sink = NULL;
+	_rng = &rng;
+	_numSubtrees = numSubtrees;
+	BuildWithMethod();
+}
+
+void ChordalGraph::SubtreeIntersection::BuildWithMethod() {
+	delete _chg._model;
+	_chg._model = new Tree(_chg._numNodes, *_rng);
+	if (_chg._method == "gs") {
+		BuildwithGrowingSubtree();
+	} else if (_chg._method == "cn") {
+		BuildwithConnectingNodes();
+	} else if (_chg._method == "pt") {
+		BuildwithPrunedTree();
+	}
+}
+
+bool ChordalGraph::SubtreeIntersection::CheckIntersection(const SubtreeList& subtrees, int subtree1Index, int subtree2Index) {
+	const int* it1 = subtrees.Begin(subtree1Index);
+	const int* it2 = subtrees.Begin(subtree2Index);
+	while (it1 != subtrees.End(subtree1Index) && it2 != subtrees.End(subtree2Index)) {
+		if (*it1 == *it2) //then they intersect
+			return true;
+		if (*it1 < *it2) ++it1;
+		else ++it2;
+	}
+	return false;
+}
+
+void ChordalGraph::SubtreeIntersection::ConstructIntersectionGraph(const SubtreeList& subtrees) {
+	ScopedTimer timer(_chg._times, PHASE_EDGES);
+	string mode = _chg._intersectionMode;
+	if (mode == "auto")
+		mode = SelectIntersectionMode(subtrees);
+	if (mode == "pairwise") {
+		ConstructIntersectionGraphPairwise(subtrees);
+	} else if (mode == "bitset") {
+		ConstructIntersectionGraphWithBitsets(subtrees);
+	} else {
+		ConstructIntersectionGraphByNodeIndex(subtrees);
+	}
+}
+
+/*
+ * the node index probes sum_v c_v(c_v-1)/2 pairs (c_v: the number of subtrees covering host tree node v), whereas the bitsets
+ * test all n(n-1)/2 pairs but each test is a short streaming AND over the overlapping word spans; large subtrees favour bitsets
+ */
+string ChordalGraph::SubtreeIntersection::SelectIntersectionMode(const SubtreeList& subtrees) {
+	int numSubtrees = subtrees.Size();
+	int numWords = (_chg._numNodes + 63) / 64;
+	if ((long long) numSubtrees * numWords * 8 > MAX_BITSET_BYTES)
+		return "index";
+	vector<long long> coverage(_chg._numNodes, 0);
+	double sumOfSpans = 0;
+	for (int i = 0; i < numSubtrees; ++i) {
+		for (const int* it = subtrees.Begin(i); it != subtrees.End(i); ++it)
+			coverage[*it]++;
+		sumOfSpans += subtrees.Back(i) / 64 - subtrees.Front(i) / 64 + 1;
+	}
+	double indexCost = 0;
+	for (int v = 0; v < _chg._numNodes; ++v)
+		indexCost += double(coverage.at(v)) * (coverage.at(v) - 1) / 2;
+	double bitsetCost = double(numSubtrees) * (numSubtrees - 1) / 2 * (1 + sumOfSpans / numSubtrees / BITSET_WORDS_PER_PROBE);
+	return (bitsetCost < indexCost) ? "bitset" : "index";
+}
+
+/*
+ * rows (subtree IDs) are handed out to the worker threads in small chunks on demand, since the triangular loop makes the first rows
+ * the most expensive; each chunk keeps its own edge buffer and the buffers are passed to the sink in chunk order, so the output does
+ * not depend on the number of threads
+ * a chunk is emitted as soon as it and all chunks before it are done, and workers wait instead of running more than
+ * MAX_PENDING_CHUNKS_PER_THREAD chunks per thread ahead, so the buffered edges stay bounded
+ */
+void ChordalGraph::SubtreeIntersection::DiscoverEdges(int numSubtrees, const NeighbourFinder& findNeighbours) {
+	int numThreads = max(1, min(_chg._numThreads, numSubtrees));
+	int chunkSize = max(1, numSubtrees / (numThreads * CHUNKS_PER_THREAD));
+	int numChunks = (numSubtrees + chunkSize - 1) / chunkSize;
+	int maxPendingChunks = numThreads * MAX_PENDING_CHUNKS_PER_THREAD;
+	vector<vector<pair<int, int>>> chunkEdges(numChunks);
+	vector<bool> chunkDone(numChunks, false);
+	int nextChunkToEmit = 0;
+	mutex chunkMutex;
+	condition_variable chunkEvent;
+	atomic<int> nextChunk(0);
+	auto findChunkEdges = [&](int chunk, vector<int>& neighbours, vector<int>& scratch) {
+		int end = min(numSubtrees, (chunk + 1) * chunkSize);
+		for (int i = chunk * chunkSize; i < end; ++i) {
+			neighbours.clear();
+			findNeighbours(i, neighbours, scratch);
+			for (unsigned int j = 0; j < neighbours.size(); ++j)
+				chunkEdges[chunk].push_back(make_pair(i, neighbours[j]));
+		}
+	};
+	auto emitChunk = [&](int chunk) {
+		for (unsigned int k = 0; k < chunkEdges[chunk].size(); ++k)
+			_sink->AddEdge(chunkEdges[chunk][k].first, chunkEdges[chunk][k].second);
+		vector<pair<int, int>>().swap(chunkEdges[chunk]); //release the buffer as soon as it is emitted
+	};
+	_sink->Begin(numSubtrees);
+	if (numThreads == 1) {
+		vector<int> neighbours, scratch;
+		for (int chunk = 0; chunk < numChunks; ++chunk) {
+			findChunkEdges(chunk, neighbours, scratch);
+			emitChunk(chunk);
+		}
+	} else {
+		auto worker = [&]() {
+			vector<int> neighbours, scratch;
+			for (int chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++) {
+				{
+					unique_lock<mutex> lock(chunkMutex);
+					chunkEvent.wait(lock, [&]() { return chunk < nextChunkToEmit + maxPendingChunks; });
+				}
+				findChunkEdges(chunk, neighbours, scratch);
+				{
+					lock_guard<mutex> lock(chunkMutex);
+					chunkDone[chunk] = true;
+				}
+				chunkEvent.notify_all();
+			}
+		};
+		vector<thread> threads;
+		for (int t = 0; t < numThreads; ++t) threads.push_back(thread(worker));
+		for (int chunk = 0; chunk < numChunks; ++chunk) {
+			{
+				unique_lock<mutex> lock(chunkMutex);
+				chunkEvent.wait(lock, [&]() { return (bool) chunkDone[chunk]; });
+			}
+			emitChunk(chunk);
+			{
+				lock_guard<mutex> lock(chunkMutex);
+				nextChunkToEmit = chunk + 1;
+			}
+			chunkEvent.notify_all();
+		}
+		for (unsigned int t = 0; t < threads.size(); ++t) threads.at(t).join();
+	}
+	_sink->End();
+}
+
+void ChordalGraph::SubtreeIntersection::ConstructIntersectionGraphPairwise(const SubtreeList& subtrees) {
+	int numSubtrees = subtrees.Size();
+	DiscoverEdges(numSubtrees, [&](int i, vector<int>& neighbours, vector<int>&) {
+		for (int j = i + 1; j < numSubtrees; ++j) {
+			if (CheckIntersection(subtrees, i, j))
+				neighbours.push_back(j);
+		}
+	});
+}
+
+/*
+ * two subtrees intersect iff they share a host tree node, so we list the subtrees covering each host tree node
+ * and take the neighbours of subtree i from the lists of its own nodes; the cost then follows the number of edges instead of n^2
+ * neighbours are added in ascending order, hence the edges (and their IDs) are exactly those of the pairwise construction
+ */
+void ChordalGraph::SubtreeIntersection::ConstructIntersectionGraphByNodeIndex(const SubtreeList& subtrees) {
+	int numSubtrees = subtrees.Size();
+	vector<long long> coverOffsets(_chg._numNodes + 1, 0); //subtrees containing host tree node v: coveringSubtrees[coverOffsets[v]] ... in ascending order
+	for (int i = 0; i < numSubtrees; ++i) {
+		for (const int* it = subtrees.Begin(i); it != subtrees.End(i); ++it)
+			coverOffsets[*it + 1]++;
+	}
+	for (int v = 0; v < _chg._numNodes; ++v)
+		coverOffsets[v + 1] += coverOffsets[v];
+	vector<int> coveringSubtrees(coverOffsets.back());
+	vector<long long> position(coverOffsets.begin(), coverOffsets.end() - 1);
+	for (int i = 0; i < numSubtrees; ++i) {
+		for (const int* it = subtrees.Begin(i); it != subtrees.End(i); ++it)
+			coveringSubtrees[position[*it]++] = i;
+	}
+	DiscoverEdges(numSubtrees, [&](int i, vector<int>& neighbours, vector<int>& lastVisitor) {
+		//lastVisitor: the last subtree whose neighbour list included that subtree, for deduplication
+		if (lastVisitor.empty()) lastVisitor.resize(numSubtrees, -1);
+		for (const int* it = subtrees.Begin(i); it != subtrees.End(i); ++it) {
+			const int* coverBegin = coveringSubtrees.data() + coverOffsets[*it];
+			const int* coverEnd = coveringSubtrees.data() + coverOffsets[*it + 1];
+			for (const int* jt = upper_bound(coverBegin, coverEnd, i); jt != coverEnd; ++jt) {
+				if (lastVisitor[*jt] != i) {
+					lastVisitor[*jt] = i;
+					neighbours.push_back(*jt);
+				}
+			}
+		}
+		sort(neighbours.begin(), neighbours.end());
+	});
+}
+
+/*
+ * each subtree becomes a bitset over the host tree nodes; a pair is only tested on the words where both bitsets can be nonzero
+ */
+void ChordalGraph::SubtreeIntersection::ConstructIntersectionGraphWithBitsets(const SubtreeList& subtrees) {
+	int numSubtrees = subtrees.Size();
+	int numWords = (_chg._numNodes + 63) / 64;
+	vector<uint64_t> bits((size_t) numSubtrees * numWords, 0);
+	vector<int> firstWord(numSubtrees), lastWord(numSubtrees); //the span of the nonzero words of each bitset
+	for (int i = 0; i < numSubtrees; ++i) {
+		uint64_t* row = &bits[(size_t) i * numWords];
+		for (const int* it = subtrees.Begin(i); it != subtrees.End(i); ++it)
+			row[*it / 64] |= uint64_t(1) << (*it % 64);
+		firstWord.at(i) = subtrees.Front(i) / 64;
+		lastWord.at(i) = subtrees.Back(i) / 64;
+	}
+	DiscoverEdges(numSubtrees, [&](int i, vector<int>& neighbours, vector<int>&) {
+		const uint64_t* row1 = &bits[(size_t) i * numWords];
+		for (int j = i + 1; j < numSubtrees; ++j) {
+			int first = max(firstWord.at(i), firstWord.at(j));
+			int last = min(lastWord.at(i), lastWord.at(j));
+			if (first > last) continue;
+			const uint64_t* row2 = &bits[(size_t) j * numWords];
+			if (BitsIntersect(row1 + first, row2 + first, last - first + 1))
+				neighbours.push_back(j);
+		}
+	});
+}
+
+void ChordalGraph::SubtreeIntersection::BuildHostTree(Tree& tr) {
+	ScopedTimer timer(_chg._times, PHASE_HOST_TREE);
+	tr.BuildRandomTree();
+}
+
+void ChordalGraph::SubtreeIntersection::BuildwithGrowingSubtree() {
+	Tree& tr = *_chg._model;
+	BuildHostTree(tr);
+	{
+		ScopedTimer timer(_chg._times, PHASE_SUBTREES);
+		for (int i = 0; i < _numSubtrees; ++i) {
+			int subtreeSize = _rng->UniformInt(1, _chg._maxSubtreeSize);
+			tr.FindAndAddGrowingSubtree(subtreeSize);
+		}
+		tr.ReleaseWorkspace();
+	}
+	if (_sink != NULL) ConstructIntersectionGraph(tr._subtreesS);
+}
+
+void ChordalGraph::SubtreeIntersection::BuildwithConnectingNodes() {
+	Tree& tr = *_chg._model;
+	BuildHostTree(tr);
+	{
+		ScopedTimer timer(_chg._times, PHASE_SUBTREES);
+		vector<int> allNodeIDs;
+		for (int i = 0; i < _chg._numNodes; ++i)
+			allNodeIDs.push_back(i);
+		double lambda = _chg._thresholdProb*_chg._numNodes;
+		PoissonSampler selector(lambda);
+		for (int i = 0; i < _numSubtrees; ++i) {
+			int numNodesToConnect = selector.Sample(*_rng);
+			if (numNodesToConnect < 0.5) {
+				numNodesToConnect = 1;
+			} else if (numNodesToConnect > _chg._numNodes + 0.1) {
+				numNodesToConnect = _chg._numNodes;
+			}
+			tr.FindAndAddSubtreeByConnNodes(numNodesToConnect, allNodeIDs);
+		}
+		tr.ReleaseWorkspace();
+	}
+	if (_sink != NULL) ConstructIntersectionGraph(tr._subtreesS);
+}
+
+void ChordalGraph::SubtreeIntersection::BuildwithPrunedTree() {
+	Tree& tr = *_chg._model;
+	BuildHostTree(tr);
+	{
+		ScopedTimer timer(_chg._times, PHASE_SUBTREES);
+		for (int i = 0; i < _numSubtrees; ++i) {
+			tr.FindAndAddSubtreeWithEdgeDeletion(_chg._edgeDelPerc, _chg._barrier);
+		}
+		tr.ReleaseWorkspace();
+	}
+	if (_sink != NULL) ConstructIntersectionGraph(tr._subtreesS);
+}
+
+
+
+void ChordalGraph::PEOBasedConstruction::Build(EdgeSink& sink, RandomEngine& rng) {
+	_sink = &sink;
+	_rng = &rng;
+	BuildPEOBased();
+}
+
+void ChordalGraph::PEOBasedConstruction::BuildPEOBased()
+{
+	_useBitMatrix = SelectBitMatrix();
+	if (_useBitMatrix) {
+		PrepareBitMatrix();
+	} else {
+		_successors.resize(_chg._numNodes);
+	}
+	_stamps.resize(_chg._numNodes, 0);
+	_cliqueStart = _chg._numNodes;
+
+	int lowerBound = 1;
+	vector<int> neighbourhood;
+	for (int i = 0; i < _chg._numNodes - 1; ++i) {
+		int upperBound = ceil((_chg._numNodes - i - 1)*_chg._upperBoundCoef);
+		int numNeighbours = _rng->UniformInt(lowerBound, upperBound);
+		if (numNeighbours < _chg._numNodes - i - 1) { // if there is room for random selection, then do it
+			neighbourhood.clear();
+			neighbourhood.push_back(i); //neighbourhood includes the node itself
+			AssignSuccesiveNeighbours(neighbourhood, numNeighbours, i);
+			if (_useBitMatrix) {
+				MakeNeighbourhoodCliqueOnBitMatrix(neighbourhood);
+			} else {
+				FindFormerSuccessiveNeighbours(i, neighbourhood);
+				MakeNeighbourhoodClique(neighbourhood);
+			}
+		} else {
+			MakeTheRestClique(i);
+			break;
+		}
+	}
+	if (_useBitMatrix) CountEdgesOfBitMatrix();
+	EmitEdges();
+}
+
+/*
+ * the numbers of successors drawn as in BuildPEOBased, without the successors themselves, summed up (with the edges of the clique
+ * at the end); a lower bound on the number of edges
+ */
+long long ChordalGraph::PEOBasedConstruction::DrawNumSuccessors(RandomEngine& rng) {
+	long long numEdges = 0;
+	int lowerBound = 1;
+	for (int i = 0; i < _chg._numNodes - 1; ++i) {
+		int upperBound = ceil((_chg._numNodes - i - 1)*_chg._upperBoundCoef);
+		int numNeighbours = rng.UniformInt(lowerBound, upperBound);
+		if (numNeighbours < _chg._numNodes - i - 1) {
+			numEdges += numNeighbours;
+		} else {
+			long long numCliqueNodes = _chg._numNodes - i;
+			numEdges += numCliqueNodes * (numCliqueNodes - 1) / 2;
+			break;
+		}
+	}
+	return numEdges;
+}
+
+/*
+ * bytes of the stamps and of the bit matrix or the successor lists of numEdges edges
+ */
+double ChordalGraph::PEOBasedConstruction::EstimateWorkspace(long long numEdges) {
+	double bytes = _chg._numNodes * (double) sizeof(int);
+	return bytes + (SelectBitMatrix() ? BitMatrixBytes() : SuccessorBytes(numEdges));
+}
+
+double ChordalGraph::PEOBasedConstruction::BitMatrixBytes() const {
+	double numWords = (_chg._numNodes + 63) / 64;
+	return numWords * _chg._numNodes / 2 * sizeof(uint64_t);
+}
+
+double ChordalGraph::PEOBasedConstruction::SuccessorBytes(double numEdges) const {
+	return _chg._numNodes * (double) sizeof(vector<int>) + numEdges * sizeof(int);
+}
+
+/*
+ * the structure of the smaller footprint: the n^2/16 bytes of the triangular bit matrix, or 4 bytes per edge in the sorted arrays,
+ * which break even at a density of about 1/32. The density is dominated by the fill-in rather than by the upperBoundCoef*(n-i)/2
+ * successors drawn for node i, so it is taken from a pilot run (see EstimatePEODensity)
+ */
+bool ChordalGraph::PEOBasedConstruction::SelectBitMatrix() {
+	if (_chg._peoAdjacency != "auto")
+		return (_chg._peoAdjacency == "bitmatrix");
+	if (BitMatrixBytes() > MAX_BITSET_BYTES)
+		return false;
+	double numEdges = _chg.EstimatePEODensity() * (double(_chg._numNodes)*(_chg._numNodes - 1) / 2);
+	return (BitMatrixBytes() <= SuccessorBytes(numEdges));
+}
+
+void ChordalGraph::PEOBasedConstruction::PrepareBitMatrix() {
+	_numWords = (_chg._numNodes + 63) / 64;
+	_rowOffsets.resize(_chg._numNodes + 1);
+	_rowOffsets[0] = 0;
+	for (int a = 0; a < _chg._numNodes; ++a)
+		_rowOffsets[a + 1] = _rowOffsets[a] + _numWords - a / 64;
+	_bitRows.assign(_rowOffsets.back(), 0);
+	_mask.assign(_numWords, 0);
+}
+
+/*
+ * the mask of the neighbourhood (with the former successors, read from the row of the node) is OR-ed into the row of each member;
+ * bits up to the member itself are cut from its first word so that a row only holds successors
+ */
+void ChordalGraph::PEOBasedConstruction::MakeNeighbourhoodCliqueOnBitMatrix(const vector<int>& neighbourhood) {
+	int nodeID = neighbourhood.front();
+	int firstWord = nodeID / 64;
+	fill(_mask.begin() + firstWord, _mask.end(), 0);
+	for (unsigned int k = 0; k < neighbourhood.size(); ++k)
+		_mask[neighbourhood[k] / 64] |= uint64_t(1) << (neighbourhood[k] % 64);
+	BitsOr(_mask.data() + firstWord, Row(nodeID), _numWords - firstWord);
+	for (int w = firstWord; w < _numWords; ++w) {
+		for (uint64_t word = _mask[w]; word != 0; word &= word - 1) {
+			int a = w * 64 + LowestBitIndex(word);
+			uint64_t* row = Row(a);
+			row[0] |= _mask[w] & ((~uint64_t(0) << (a % 64)) << 1);
+			BitsOr(row + 1, _mask.data() + w + 1, _numWords - w - 1);
+		}
+	}
+}
+
+void ChordalGraph::PEOBasedConstruction::CountEdgesOfBitMatrix() {
+	long long numCliqueNodes = _chg._numNodes - _cliqueStart;
+	_numEdges = numCliqueNodes * (numCliqueNodes - 1) / 2;
+	for (int a = 0; a < _cliqueStart; ++a) {
+		const uint64_t* row = Row(a);
+		for (int w = 0; w < _numWords - a / 64; ++w)
+			_numEdges += PopCount(row[w]);
+	}
+}
+
+/*
+ * draws numNeighbours distinct successors uniformly and appends them in ascending order;
+ * Floyd's algorithm is run for the smaller one of the sample and its complement, so the cost is O(k log k) for a sample of size k
+ * and linear in the output for large samples, where rejection sampling would degrade
+ */
+void ChordalGraph::PEOBasedConstruction::AssignSuccesiveNeighbours(vector<int>& neighbourhood, int numNeighbours, int nodeID) {
+	int numCandidates = _chg._numNodes - nodeID - 1;
+	bool complement = (2 * numNeighbours > numCandidates);
+	int numToDraw = complement ? numCandidates - numNeighbours : numNeighbours;
+	_currentStamp++;
+	size_t firstSampled = neighbourhood.size();
+	for (int j = numCandidates - numToDraw; j < numCandidates; ++j) {
+		int t = (int) _rng->Below(j + 1);
+		int neighbourID = (_stamps[nodeID + 1 + t] == _currentStamp) ? nodeID + 1 + j : nodeID + 1 + t;
+		_stamps[neighbourID] = _currentStamp;
+		if (!complement) neighbourhood.push_back(neighbourID);
+	}
+	if (complement) {
+		for (int neighbourID = nodeID + 1; neighbourID < _chg._numNodes; ++neighbourID) {
+			if (_stamps[neighbourID] != _currentStamp) neighbourhood.push_back(neighbourID);
+		}
+	} else {
+		sort(neighbourhood.begin() + firstSampled, neighbourhood.end());
+	}
+}
+
+/*
+ * merges the successors that the node already has into the (sorted) neighbourhood
+ */
+void ChordalGraph::PEOBasedConstruction::FindFormerSuccessiveNeighbours(int nodeID, vector<int>& neighbours) {
+	const vector<int>& successors = _successors.at(nodeID);
+	if (successors.empty()) return;
+	size_t numNeighbours = neighbours.size();
+	neighbours.insert(neighbours.end(), successors.begin(), successors.end());
+	inplace_merge(neighbours.begin(), neighbours.begin() + numNeighbours, neighbours.end());
+	neighbours.erase(unique(neighbours.begin(), neighbours.end()), neighbours.end());
+}
+
+/*
+ * adds the sorted range [first, last) of larger node IDs to the successors of the node, merging from the back in place;
+ * returns the number of new edges
+ */
+int ChordalGraph::PEOBasedConstruction::MergeIntoSuccessors(int nodeID, const int* first, const int* last) {
+	vector<int>& successors = _successors[nodeID];
+	int numNew = 0;
+	vector<int>::const_iterator it = successors.begin();
+	for (const int* jt = first; jt != last; ++jt) {
+		while (it != successors.end() && *it < *jt) ++it;
+		if (it == successors.end() || *it != *jt) numNew++;
+	}
+	if (numNew == 0) return 0;
+	int read = successors.size() - 1;
+	successors.resize(successors.size() + numNew);
+	int write = successors.size() - 1;
+	for (const int* jt = last - 1; jt >= first; --jt) {
+		while (read >= 0 && successors[read] > *jt) successors[write--] = successors[read--];
+		if (read >= 0 && successors[read] == *jt) read--;
+		successors[write--] = *jt;
+	}
+	return numNew;
+}
+
+void ChordalGraph::PEOBasedConstruction::MakeNeighbourhoodClique(const vector<int>& neighbourhood) {
+	long long edgeCounter = 0;
+	for (size_t k = 0; k + 1 < neighbourhood.size(); ++k) {
+		edgeCounter += MergeIntoSuccessors(neighbourhood[k], neighbourhood.data() + k + 1, neighbourhood.data() + neighbourhood.size());
+	}
+	_numEdges += edgeCounter;
+}
+
+/*
+ * the nodes from nodeID on form a clique: its edges are counted in closed form and emitted only when the graph is built
+ */
+void ChordalGraph::PEOBasedConstruction::MakeTheRestClique(int nodeID) {
+	_cliqueStart = nodeID;
+	if (_useBitMatrix) return; //counted with the popcounts
+	long long numCliqueNodes = _chg._numNodes - nodeID;
+	long long numExistingEdges = 0;
+	for (int i = nodeID; i < _chg._numNodes; ++i) {
+		numExistingEdges += _successors.at(i).size();
+		vector<int>().swap(_successors.at(i));
+	}
+	_numEdges += numCliqueNodes * (numCliqueNodes - 1) / 2 - numExistingEdges;
+}
+
+void ChordalGraph::PEOBasedConstruction::EmitEdges()
+{
+	_sink->Begin(_chg._numNodes);
+	for (int i = 0; i < _chg._numNodes - 1; ++i) {
+		if (i < _cliqueStart && _useBitMatrix) {
+			const uint64_t* row = Row(i);
+			for (int w = i / 64; w < _numWords; ++w) {
+				for (uint64_t word = row[w - i / 64]; word != 0; word &= word - 1)
+					_sink->AddEdge(i, w * 64 + LowestBitIndex(word));
+			}
+		} else if (i < _cliqueStart) {
+			for (unsigned int k = 0; k < _successors.at(i).size(); ++k)
+				_sink->AddEdge(i, _successors.at(i).at(k));
+			vector<int>().swap(_successors.at(i));
+		} else {
+			for (int j = i + 1; j < _chg._numNodes; ++j)
+				_sink->AddEdge(i, j);
+		}
+	}
+	vector<uint64_t>().swap(_bitRows);
+	_sink->End();
+}
\ No newline at end of file
@@ -1,76 +1,145 @@
-#ifndef CHORDALGRAPH_H_
-#define CHORDALGRAPH_H_
-
-#include "common.h"
-#include "global.h"
-
-
-class ChordalGenerationParams {
-public:
-	string _method = "";
-	int _numNodes = -1;
-	int _maxSubtreeSize = -1;                                    //param for growingSubtree (in terms of the number of nodes)
-	double _thresholdProb = -1;                                  //param for connectingNodes
-	double _edgeDelPerc = -1, _barrier = -1;                     //params for prunedTree
-	double _upperBoundCoef = -1; 				     //params for peoBased
-
-	ChordalGenerationParams(string method) : _method(method) {}
-};
-
-
-class ChordalGraph {
-public:
-	ChordalGraph(ChordalGenerationParams params);
-	void Build();
-	double GetBuildTime() const { return _timeToBuild; }
-	void CollectAndWriteStats(string fileName, string instanceInfoCSVFileName, string cliqueSizeInfoCSVFileName);
-	void WriteGraphToFile(string fileName) { graphWriter(_g, fileName).run();}
-	const Graph& GetGraph() { return _g; }
-
-private:
-	class SubtreeIntersection {
-	public:
-		SubtreeIntersection(ChordalGraph& chg) : _chg(chg) {}
-		void Build();
-	private:
-		ChordalGraph& _chg;
-		void BuildwithGrowingSubtree();
-		void BuildwithPrunedTree();
-		void BuildwithConnectingNodes();
-		bool CheckIntersection(const vector<set<int>>& subtrees, int subtree1Index, int subtree2Index);
-		void ConstructIntersectionGraph(const vector<set<int>>& subtrees);
-	};
-
-	class PEOBasedConstruction {
-	public:
-		PEOBasedConstruction(ChordalGraph& chg): _chg(chg) {}
-		void Build();
-	private:
-		ChordalGraph& _chg;
-		vector<set<int>> _adjList;
-		vector<int> _peo;
-		int _numEdges = 0;
-		void BuildPEOBased();
-		void AssignSuccesiveNeighbours(set<int>& neighbourhood, int numNeighbours, int nodeID);
-		void FindFormerSuccessiveNeighbours(int nodeID, set<int>& neighbours);
-		void MakeNeighbourhoodClique(const set<int>& neighbourhood);
-		void MakeTheRestClique(int nodeID);
-		void ConvertToLemonObject();
-	};
-
-
-	int _numNodes;
-	Graph _g;
-	int _maxSubtreeSize;                            //param for growingSubtree (in terms of the number of nodes)
-	double _thresholdProb;                          //param for connectingNodes
-	double _edgeDelPerc, _barrier;                  //params for prunedTree
-	double _upperBoundCoef; 			//param for peoBased
-	double _timeToBuild;
-	string _method;
-	PEOBasedConstruction _peoBased;
-	SubtreeIntersection _subtreeIntersection;
-
-};
-
-
-#endif
+#ifndef CHORDALGRAPH_H_
+#define CHORDALGRAPH_H_
+
+#include "common.h"
+#include "random.h"
+#include "csrgraph.h"
+#include "edgesink.h"
+#include "timing.h"
+
+class SubtreeList;
+class Tree;
+
+
+class ChordalGenerationParams {
+public:
+	string _method = "";
+	int _numNodes = -1;
+	int _maxSubtreeSize = -1;                                    //param for growingSubtree (in terms of the number of nodes)
+	double _thresholdProb = -1;                                  //param for connectingNodes
+	double _edgeDelPerc = -1, _barrier = -1;                     //params for prunedTree
+	double _upperBoundCoef = -1; 				     //params for peoBased
+	string _intersectionMode = "auto";                           //pairwise, index, bitset or auto (construction of the subtree intersection graph)
+	int _numThreads = 1;                                         //worker threads of the subtree intersection graph construction
+	string _peoAdjacency = "auto";                               //sparse, bitmatrix or auto (adjacency of peoBased during construction)
+	uint64_t _seed = 0, _stream = 0;                             //the random stream of the instance (see RandomEngine)
+
+	ChordalGenerationParams(string method) : _method(method) {}
+};
+
+
+class ChordalGraph {
+public:
+	ChordalGraph(ChordalGenerationParams params);
+	~ChordalGraph();
+	void Build();
+	void Build(EdgeSink& sink);
+	void BuildModel();
+	double CalibrateDensity(double targetDensity);
+	long long EstimateNumEdges(long long& lowerBound);
+	double EstimateMemory(long long numEdges, bool streamed);
+	double GetBuildTime() const { return _timeToBuild; }
+	const PhaseTimes& GetPhaseTimes() const { return _times; }
+	long long GetNumEdges() const;
+	void CollectAndWriteStats(string fileName, string instanceInfoCSVFileName, string cliqueSizeInfoCSVFileName, string cliqueTreeFileName = "", bool* isChordal = NULL);
+	double CollectStats(string fileName, ostream& instanceInfo, ostream& cliqueSizeInfo, string cliqueTreeFileName = "", bool* isChordal = NULL);
+	bool WriteGraphToFile(string fileName);
+	bool WriteBinaryGraphToFile(string fileName);
+	bool WriteModelToFile(string fileName);
+	vector<double> GetMethodParams() const;
+	const CSRGraph& GetGraph() { return _g; }
+	void ConvertToLemon(Graph& g) const { _g.ConvertToLemon(g); }
+
+private:
+	class SubtreeIntersection {
+	public:
+		SubtreeIntersection(ChordalGraph& chg) : _chg(chg) {}
+		void Build(EdgeSink& sink, RandomEngine& rng);
+		void BuildModel(RandomEngine& rng);
+		void BuildSample(RandomEngine& rng, int numSubtrees);
+	private:
+		ChordalGraph& _chg;
+		EdgeSink* _sink = NULL;                 //NULL if only the model is built
+		RandomEngine* _rng = NULL;
+		int _numSubtrees = 0;                   //the number of nodes of the graph, or of the subtrees of a sample
+		void BuildWithMethod();
+		void BuildHostTree(Tree& tr);
+		void BuildwithGrowingSubtree();
+		void BuildwithPrunedTree();
+		void BuildwithConnectingNodes();
+		bool CheckIntersection(const SubtreeList& subtrees, int subtree1Index, int subtree2Index);
+		void ConstructIntersectionGraph(const SubtreeList& subtrees);
+		void ConstructIntersectionGraphPairwise(const SubtreeList& subtrees);
+		void ConstructIntersectionGraphByNodeIndex(const SubtreeList& subtrees);
+		void ConstructIntersectionGraphWithBitsets(const SubtreeList& subtrees);
+		string SelectIntersectionMode(const SubtreeList& subtrees);
+		typedef function<void(int, vector<int>&, vector<int>&)> NeighbourFinder; //(subtree ID, its neighbours with larger IDs, scratch of the thread)
+		void DiscoverEdges(int numSubtrees, const NeighbourFinder& findNeighbours);
+	};
+
+	class PEOBasedConstruction {
+	public:
+		PEOBasedConstruction(ChordalGraph& chg): _chg(chg) {}
+		void Build(EdgeSink& sink, RandomEngine& rng);
+		long long DrawNumSuccessors(RandomEngine& rng);
+		double EstimateWorkspace(long long numEdges);
+	private:
+		ChordalGraph& _chg;
+		EdgeSink* _sink = NULL;
+		RandomEngine* _rng = NULL;
+		vector<vector<int>> _successors;   //sorted neighbours with larger IDs of each node, for the nodes before _cliqueStart
+		vector<int> _peo;
+		long long _numEdges = 0;
+		int _cliqueStart = 0;               //nodes from _cliqueStart on form a clique, which is not stored explicitly
+		vector<int> _stamps;                //marks of the sampled successors (_stamps[v] == _currentStamp)
+		int _currentStamp = 0;
+		void BuildPEOBased();
+		void AssignSuccesiveNeighbours(vector<int>& neighbourhood, int numNeighbours, int nodeID);
+		void FindFormerSuccessiveNeighbours(int nodeID, vector<int>& neighbours);
+		void MakeNeighbourhoodClique(const vector<int>& neighbourhood);
+		void MakeTheRestClique(int nodeID);
+		int MergeIntoSuccessors(int nodeID, const int* first, const int* last);
+		bool _useBitMatrix = false;
+		int _numWords = 0;
+		vector<uint64_t> _bitRows;          //upper triangular bit matrix: the row of node a holds its successors from word a/64 on
+		vector<size_t> _rowOffsets;
+		vector<uint64_t> _mask;             //the neighbourhood being made a clique
+		uint64_t* Row(int nodeID) { return _bitRows.data() + _rowOffsets[nodeID]; }
+		bool SelectBitMatrix();
+		double BitMatrixBytes() const;
+		double SuccessorBytes(double numEdges) const;
+		void PrepareBitMatrix();
+		void MakeNeighbourhoodCliqueOnBitMatrix(const vector<int>& neighbourhood);
+		void CountEdgesOfBitMatrix();
+		void EmitEdges();
+	};
+
+
+	int _numNodes;
+	CSRGraph _g;
+	int _maxSubtreeSize;                            //param for growingSubtree (in terms of the number of nodes)
+	double _thresholdProb;                          //param for connectingNodes
+	double _edgeDelPerc, _barrier;                  //params for prunedTree
+	double _upperBoundCoef; 			//param for peoBased
+	string _intersectionMode;                       //pairwise, index, bitset or auto
+	int _numThreads;
+	string _peoAdjacency;                           //sparse, bitmatrix or auto
+	RandomEngine _rng;
+	double _timeToBuild;                            //wall-clock seconds
+	PhaseTimes _times;
+	bool _streamed;                                 //the edges were only streamed to a sink, _g is empty and _counts holds the counts
+	CountingSink _counts;
+	Tree* _model;                                   //host tree and subtrees of gs, cn and pt, kept for the statistics
+	bool _modelOnly;                                //only _model was built, without the edges
+	double _pilotDensity;                           //density of the pilot run of peo, -1 until it is run
+	string _method;
+	PEOBasedConstruction _peoBased;
+	SubtreeIntersection _subtreeIntersection;
+	double EstimateDensity(int numNodes);
+	double RunPEOPilot(int numNodes, double upperBoundCoef, uint64_t seed);
+	double EstimatePEODensity();
+
+};
+
+
+#endif
@@ -0,0 +1,214 @@
+#include "csrgraph.h"
+#include "edgesink.h"
+
+/*
+ * a counting pass for the degrees and a single fill pass; if the edges are given as (u,v) with u<v in ascending order
+ * (as all generators produce them) the neighbour lists come out sorted, otherwise they are sorted afterwards
+ */
+void CSRGraph::Build(int numNodes, const vector<pair<int, int>>& edges) {
+	_numNodes = numNodes;
+	_numEdges = edges.size();
+	_offsets.assign(numNodes + 1, 0);
+	for (size_t k = 0; k < edges.size(); ++k) {
+		_offsets[edges[k].first + 1]++;
+		_offsets[edges[k].second + 1]++;
+	}
+	for (int u = 0; u < numNodes; ++u)
+		_offsets[u + 1] += _offsets[u];
+	_neighbours.resize(2 * _numEdges);
+	vector<long long> position(_offsets.begin(), _offsets.end() - 1);
+	bool sortedInput = true;
+	for (size_t k = 0; k < edges.size(); ++k) {
+		int u = edges[k].first, v = edges[k].second;
+		_neighbours[position[u]++] = v;
+		_neighbours[position[v]++] = u;
+		if (u > v || (k > 0 && edges[k] < edges[k - 1])) sortedInput = false;
+	}
+	if (!sortedInput) {
+		for (int u = 0; u < numNodes; ++u)
+			sort(_neighbours.begin() + _offsets[u], _neighbours.begin() + _offsets[u + 1]);
+	}
+}
+
+/*
+ * copies arrays that are already in this form, e.g. the ones of a mapped binary graph file
+ */
+void CSRGraph::Assign(int numNodes, long long numEdges, const long long* offsets, const int* neighbours) {
+	_numNodes = numNodes;
+	_numEdges = numEdges;
+	_offsets.assign(offsets, offsets + numNodes + 1);
+	_neighbours.assign(neighbours, neighbours + 2 * numEdges);
+}
+
+static bool ParseLabel(const char* first, const char* last, long long& label) {
+	char* tokenEnd;
+	label = strtoll(first, &tokenEnd, 10);
+	return first != last && tokenEnd == last;
+}
+
+/*
+ * a single pass over the file read at once: the node labels of the @nodes section are mapped to 0..n-1 in the order of the rows
+ * (without a map if they already are 0..n-1, as graphWriter writes them), and the first two columns of the @edges section give the
+ * end nodes; other columns and sections are skipped, and the labels should be integers
+ */
+bool CSRGraph::ReadLGF(string fileName) {
+	ifstream file(fileName, ios::in | ios::binary);
+	if (!file) {
+		cout << "Cannot open " << fileName << "!" << endl;
+		return false;
+	}
+	file.seekg(0, ios::end);
+	size_t fileSize = (size_t) file.tellg();
+	file.seekg(0, ios::beg);
+	vector<char> text(fileSize + 1);
+	file.read(text.data(), fileSize);
+	text[fileSize] = '\0';
+	file.close();
+
+	enum { OTHER, NODES, EDGES } section = OTHER;
+	bool captionLine = false;
+	int labelColumn = -1, numNodes = 0;
+	bool identityLabels = true;
+	vector<long long> labels;
+	vector<pair<long long, long long>> labelledEdges;
+	const char* p = text.data();
+	const char* end = p + fileSize;
+	while (p < end) {
+		const char* lineEnd = (const char*) memchr(p, '\n', end - p);
+		if (lineEnd == NULL) lineEnd = end;
+		while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+		if (p == lineEnd || *p == '#') {
+			p = lineEnd + 1;
+			continue;
+		}
+		if (*p == '@') {
+			section = strncmp(p, "@nodes", 6) == 0 ? NODES : strncmp(p, "@edges", 6) == 0 ? EDGES : OTHER;
+			captionLine = section != OTHER;
+			p = lineEnd + 1;
+			continue;
+		}
+		if (captionLine) { //the column names
+			captionLine = false;
+			if (section == NODES) {
+				labelColumn = -1;
+				for (int column = 0; p < lineEnd; ++column) {
+					const char* token = p;
+					while (p < lineEnd && !isspace((unsigned char) *p)) ++p;
+					if (p - token == 5 && strncmp(token, "label", 5) == 0) labelColumn = column;
+					while (p < lineEnd && isspace((unsigned char) *p)) ++p;
+				}
+			}
+			p = lineEnd + 1;
+			continue;
+		}
+		if (section == OTHER) {
+			p = lineEnd + 1;
+			continue;
+		}
+		if (section == NODES) {
+			long long label = numNodes; //the rows are numbered if there is no label column
+			for (int column = 0; column <= labelColumn && p < lineEnd; ++column) {
+				const char* token = p;
+				while (p < lineEnd && !isspace((unsigned char) *p)) ++p;
+				if (column == labelColumn && !ParseLabel(token, p, label)) {
+					cout << fileName << ": integer labels are expected!" << endl;
+					return false;
+				}
+				while (p < lineEnd && isspace((unsigned char) *p)) ++p;
+			}
+			if (label != numNodes) identityLabels = false;
+			labels.push_back(label);
+			numNodes++;
+		} else {
+			long long endNodes[2];
+			for (int column = 0; column < 2; ++column) {
+				const char* token = p;
+				while (p < lineEnd && !isspace((unsigned char) *p)) ++p;
+				if (!ParseLabel(token, p, endNodes[column])) {
+					cout << fileName << ": integer labels are expected!" << endl;
+					return false;
+				}
+				while (p < lineEnd && isspace((unsigned char) *p)) ++p;
+			}
+			labelledEdges.push_back(make_pair(endNodes[0], endNodes[1]));
+		}
+		p = lineEnd + 1;
+	}
+
+	unordered_map<long long, int> nodeOfLabel;
+	if (!identityLabels) {
+		nodeOfLabel.reserve(numNodes);
+		for (int u = 0; u < numNodes; ++u)
+			nodeOfLabel[labels[u]] = u;
+	}
+	vector<pair<int, int>> edges;
+	edges.reserve(labelledEdges.size());
+	for (size_t k = 0; k < labelledEdges.size(); ++k) {
+		long long u = labelledEdges[k].first, v = labelledEdges[k].second;
+		if (!identityLabels) {
+			unordered_map<long long, int>::iterator itU = nodeOfLabel.find(u), itV = nodeOfLabel.find(v);
+			u = itU == nodeOfLabel.end() ? -1 : itU->second;
+			v = itV == nodeOfLabel.end() ? -1 : itV->second;
+		}
+		if (u < 0 || v < 0 || u >= numNodes || v >= numNodes) {
+			cout << fileName << ": an edge has an unknown end node!" << endl;
+			return false;
+		}
+		edges.push_back(make_pair(int(min(u, v)), int(max(u, v))));
+	}
+	Build(numNodes, edges);
+	return true;
+}
+
+int CSRGraph::CountConnectedComponents() const {
+	vector<bool> visited(_numNodes, false);
+	vector<int> queue;
+	queue.reserve(_numNodes);
+	int numConnComps = 0;
+	for (int s = 0; s < _numNodes; ++s) {
+		if (visited[s]) continue;
+		numConnComps++;
+		visited[s] = true;
+		queue.clear();
+		queue.push_back(s);
+		for (size_t head = 0; head < queue.size(); ++head) {
+			for (const int* it = NeighboursBegin(queue[head]); it != NeighboursEnd(queue[head]); ++it) {
+				if (!visited[*it]) {
+					visited[*it] = true;
+					queue.push_back(*it);
+				}
+			}
+		}
+	}
+	return numConnComps;
+}
+
+/*
+ * node IDs are kept, and edges get their IDs in ascending (u,v) order, u<v
+ */
+void CSRGraph::ConvertToLemon(Graph& g) const {
+	g.clear();
+	for (int u = 0; u < _numNodes; ++u) g.addNode();
+	for (int u = 0; u < _numNodes; ++u) {
+		for (const int* it = lower_bound(NeighboursBegin(u), NeighboursEnd(u), u + 1); it != NeighboursEnd(u); ++it)
+			g.addEdge(g.nodeFromId(u), g.nodeFromId(*it));
+	}
+}
+
+/*
+ * edges (u,v), u<v, in ascending order, as the generators produce them
+ */
+void CSRGraph::EmitEdges(EdgeSink& sink) const {
+	sink.Begin(_numNodes);
+	for (int u = 0; u < _numNodes; ++u) {
+		for (const int* it = lower_bound(NeighboursBegin(u), NeighboursEnd(u), u + 1); it != NeighboursEnd(u); ++it)
+			sink.AddEdge(u, *it);
+	}
+	sink.End();
+}
+
+bool CSRGraph::WriteLGF(string fileName) const {
+	LGFWriterSink writer(fileName);
+	EmitEdges(writer);
+	return writer.Succeeded();
+}
\ No newline at end of file
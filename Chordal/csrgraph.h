@@ -0,0 +1,37 @@
+#ifndef CSRGRAPH_H_
+#define CSRGRAPH_H_
+
+#include "common.h"
+
+class EdgeSink;
+
+/*
+ * undirected simple graph in compressed sparse row form: the neighbours of node u are _neighbours[_offsets[u]] ... _neighbours[_offsets[u+1]-1]
+ * in ascending order, and each edge appears once in the adjacency of both of its end nodes
+ */
+class CSRGraph {
+public:
+	CSRGraph() : _numNodes(0), _numEdges(0) { _offsets.push_back(0); }
+	void Build(int numNodes, const vector<pair<int, int>>& edges);
+	void Assign(int numNodes, long long numEdges, const long long* offsets, const int* neighbours);
+	bool ReadLGF(string fileName);
+	int GetNumNodes() const { return _numNodes; }
+	long long GetNumEdges() const { return _numEdges; }
+	int GetDegree(int u) const { return int(_offsets[u + 1] - _offsets[u]); }
+	const int* NeighboursBegin(int u) const { return _neighbours.data() + _offsets[u]; }
+	const int* NeighboursEnd(int u) const { return _neighbours.data() + _offsets[u + 1]; }
+	const vector<long long>& GetOffsets() const { return _offsets; }
+	const vector<int>& GetNeighbours() const { return _neighbours; }
+	int CountConnectedComponents() const;
+	void ConvertToLemon(Graph& g) const;
+	void EmitEdges(EdgeSink& sink) const;
+	bool WriteLGF(string fileName) const;
+
+private:
+	int _numNodes;
+	long long _numEdges;
+	vector<long long> _offsets;
+	vector<int> _neighbours;
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "edgesink.h"
+
+#define WRITE_BUFFER_SIZE (1 << 20)
+
+void CountingSink::Begin(int numNodes) {
+	_numNodes = _numConnComps = numNodes;
+	_numEdges = 0;
+	_degrees.assign(numNodes, 0);
+	_components.resize(numNodes);
+	iota(_components.begin(), _components.end(), 0);
+}
+
+int CountingSink::FindRoot(int u) {
+	while (_components[u] != u) {
+		_components[u] = _components[_components[u]]; //path halving
+		u = _components[u];
+	}
+	return u;
+}
+
+void CountingSink::AddEdge(int u, int v) {
+	_numEdges++;
+	_degrees[u]++;
+	_degrees[v]++;
+	int root1 = FindRoot(u), root2 = FindRoot(v);
+	if (root1 != root2) {
+		_components[max(root1, root2)] = min(root1, root2);
+		_numConnComps--;
+	}
+}
+
+/*
+ * the text is the same as graphWriter writes for a LEMON graph whose edges were added in the order they arrive here
+ */
+void LGFWriterSink::Begin(int numNodes) {
+	_file.open(_fileName, ios::out);
+	_failed = !_file;
+	if (_failed) cout << "Cannot open " << _fileName << " for writing!" << endl;
+	_buffer.reserve(WRITE_BUFFER_SIZE + 64);
+	_buffer.clear();
+	_numEdges = 0;
+	const char* nodesHeader = "@nodes\nlabel\t\n";
+	_buffer.insert(_buffer.end(), nodesHeader, nodesHeader + strlen(nodesHeader));
+	for (int u = 0; u < numNodes; ++u) {
+		Append(u, '\t');
+		_buffer.push_back('\n');
+	}
+	const char* edgesHeader = "@edges\n\t\tlabel\t\n";
+	_buffer.insert(_buffer.end(), edgesHeader, edgesHeader + strlen(edgesHeader));
+}
+
+void LGFWriterSink::AddEdge(int u, int v) {
+	Append(u, '\t');
+	Append(v, '\t');
+	Append(_numEdges++, '\t');
+	_buffer.push_back('\n');
+}
+
+void LGFWriterSink::End() {
+	Flush();
+	if (_failed) return;
+	_file.close();
+	if (!_file) {
+		cout << "Cannot write " << _fileName << "!" << endl;
+		_failed = true;
+	}
+}
+
+void LGFWriterSink::Append(long long value, char separator) {
+	char digits[24];
+	int numDigits = 0;
+	do {
+		digits[numDigits++] = char('0' + value % 10);
+		value /= 10;
+	} while (value > 0);
+	while (numDigits > 0)
+		_buffer.push_back(digits[--numDigits]);
+	_buffer.push_back(separator);
+	if (_buffer.size() >= WRITE_BUFFER_SIZE) Flush();
+}
+
+void LGFWriterSink::Flush() {
+	if (!_failed) {
+		_file.write(_buffer.data(), _buffer.size());
+		if (!_file) {
+			cout << "Cannot write " << _fileName << "!" << endl;
+			_failed = true;
+		}
+	}
+	_buffer.clear();
+}
+
+void GraphBuilderSink::End() {
+	_g.Build(_numNodes, _edges);
+	vector<pair<int, int>>().swap(_edges);
+}
@@ -0,0 +1,91 @@
+#ifndef EDGESINK_H_
+#define EDGESINK_H_
+
+#include "common.h"
+#include "csrgraph.h"
+
+/*
+ * receives the edges of a generated graph: Begin once with the number of nodes, then every edge (u,v) with u<v exactly once,
+ * in ascending (u,v) order, then End
+ */
+class EdgeSink {
+public:
+	virtual ~EdgeSink() {}
+	virtual void Begin(int numNodes) = 0;
+	virtual void AddEdge(int u, int v) = 0;
+	virtual void End() {}
+};
+
+/*
+ * keeps only the counts: the number of edges, the degrees and the connected components (union-find over the nodes)
+ */
+class CountingSink : public EdgeSink {
+public:
+	void Begin(int numNodes);
+	void AddEdge(int u, int v);
+	int GetNumNodes() const { return _numNodes; }
+	long long GetNumEdges() const { return _numEdges; }
+	int GetNumConnComps() const { return _numConnComps; }
+	const vector<int>& GetDegrees() const { return _degrees; }
+
+private:
+	int _numNodes = 0, _numConnComps = 0;
+	long long _numEdges = 0;
+	vector<int> _degrees;
+	vector<int> _components;
+	int FindRoot(int u);
+};
+
+/*
+ * writes the graph to an .lgf file as the edges arrive, through a large buffer; check Succeeded() after End()
+ */
+class LGFWriterSink : public EdgeSink {
+public:
+	LGFWriterSink(string fileName) : _fileName(fileName) {}
+	void Begin(int numNodes);
+	void AddEdge(int u, int v);
+	void End();
+	bool Succeeded() const { return !_failed; }
+
+private:
+	string _fileName;
+	ofstream _file;
+	bool _failed = false;                   //the file could not be opened or written, which is reported once
+	vector<char> _buffer;
+	long long _numEdges = 0;
+	void Append(long long value, char separator);
+	void Flush();
+};
+
+/*
+ * collects the edges into a buffer and builds the CSR graph at the end
+ */
+class GraphBuilderSink : public EdgeSink {
+public:
+	GraphBuilderSink(CSRGraph& g) : _g(g) {}
+	void Begin(int numNodes) { _numNodes = numNodes; _edges.clear(); }
+	void AddEdge(int u, int v) { _edges.push_back(make_pair(u, v)); }
+	void End();
+
+private:
+	CSRGraph& _g;
+	int _numNodes = 0;
+	vector<pair<int, int>> _edges;
+};
+
+/*
+ * passes every call to two sinks
+ */
+class TeeSink : public EdgeSink {
+public:
+	TeeSink(EdgeSink& sink1, EdgeSink& sink2) : _sink1(sink1), _sink2(sink2) {}
+	void Begin(int numNodes) { _sink1.Begin(numNodes); _sink2.Begin(numNodes); }
+	void AddEdge(int u, int v) { _sink1.AddEdge(u, v); _sink2.AddEdge(u, v); }
+	void End() { _sink1.End(); _sink2.End(); }
+
+private:
+	EdgeSink& _sink1;
+	EdgeSink& _sink2;
+};
+
+#endif
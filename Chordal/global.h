@@ -1,10 +0,0 @@
-#ifndef GLOBAL_H_
-#define GLOBAL_H_
-
-#include <iostream>
-#include <random>
-
-extern std::random_device rand_dev;
-extern std::mt19937 generator; 
-
-#endif
\ No newline at end of file
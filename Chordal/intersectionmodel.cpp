@@ -0,0 +1,200 @@
+#include "intersectionmodel.h"
+#include "tree.h"
+#include <limits.h>
+
+/*
+ * four sequential writes: the header, the parents (padded), and the two arrays of the subtrees as they are in memory
+ */
+bool IntersectionModel::Write(string fileName, const Tree& tree, string method, const vector<double>& params) {
+	IntersectionModelHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header._magic, INTERSECTION_MODEL_MAGIC, sizeof(header._magic));
+	header._version = INTERSECTION_MODEL_VERSION;
+	header._byteOrder = INTERSECTION_MODEL_BYTE_ORDER;
+	header._headerSize = sizeof(IntersectionModelHeader);
+	header._numHostNodes = tree._numNodes;
+	header._numSubtrees = tree._subtreesS.Size();
+	header._totalSubtreeSize = tree._subtreesS.GetTotalSize();
+	header._numEdges = tree.CountIntersectionEdges();
+	strncpy(header._method, method.c_str(), sizeof(header._method) - 1);
+	for (int i = 0; i < 4; ++i)
+		header._params[i] = i < (int) params.size() ? params[i] : -1;
+
+	ofstream file(fileName, ios::out | ios::binary);
+	if (!file) {
+		cout << "Cannot open " << fileName << " for writing!" << endl;
+		return false;
+	}
+	const char padding[8] = {0};
+	file.write((const char*) &header, sizeof(header));
+	file.write((const char*) tree._parent.data(), tree._parent.size() * sizeof(int));
+	file.write(padding, (tree._parent.size() % 2) * sizeof(int));
+	file.write((const char*) tree._subtreesS.GetOffsets().data(), tree._subtreesS.GetOffsets().size() * sizeof(int64_t));
+	file.write((const char*) tree._subtreesS.GetNodes().data(), tree._subtreesS.GetNodes().size() * sizeof(int));
+	file.close();
+	if (!file) {
+		cout << "Cannot write " << fileName << "!" << endl;
+		return false;
+	}
+	return true;
+}
+
+bool IntersectionModel::Open(string fileName) {
+	Close();
+	if (!_file.Open(fileName)) return false;
+	if (!Validate(fileName)) {
+		Close();
+		return false;
+	}
+	BuildIndex();
+	return true;
+}
+
+bool IntersectionModel::Validate(string fileName) {
+	const char* data = _file.GetData();
+	size_t size = _file.GetSize();
+	_header = (const IntersectionModelHeader*) data;
+	if (size < sizeof(IntersectionModelHeader) || memcmp(_header->_magic, INTERSECTION_MODEL_MAGIC, sizeof(_header->_magic)) != 0) {
+		cout << fileName << " is not an intersection model file!" << endl;
+		return false;
+	}
+	if (_header->_version != INTERSECTION_MODEL_VERSION) {
+		cout << fileName << " has version " << _header->_version << ", only version " << INTERSECTION_MODEL_VERSION << " can be read!" << endl;
+		return false;
+	}
+	if (_header->_byteOrder != INTERSECTION_MODEL_BYTE_ORDER) {
+		cout << fileName << " was written on a machine of another byte order!" << endl;
+		return false;
+	}
+	int64_t numHostNodes = _header->_numHostNodes, numSubtrees = _header->_numSubtrees, totalSize = _header->_totalSubtreeSize;
+	int64_t parentBytes = (numHostNodes + numHostNodes % 2) * sizeof(int);
+	uint64_t headerSize = _header->_headerSize;
+	// the counts of nodes are bounded first, so the bytes before the subtree nodes cannot overflow, and totalSize by the bytes left after them
+	if (numHostNodes < 1 || numHostNodes > INT_MAX || numSubtrees < 0 || numSubtrees > INT_MAX || totalSize < 0
+		|| headerSize < sizeof(IntersectionModelHeader) || headerSize % sizeof(int64_t) != 0
+		|| size < headerSize + parentBytes + (numSubtrees + 1) * sizeof(int64_t)
+		|| (uint64_t) totalSize > (size - headerSize - parentBytes - (numSubtrees + 1) * sizeof(int64_t)) / sizeof(int)) {
+		cout << fileName << " is truncated or corrupt!" << endl;
+		return false;
+	}
+	_numHostNodes = (int) numHostNodes;
+	_numSubtrees = (int) numSubtrees;
+	_parent = (const int*) (data + _header->_headerSize);
+	_offsets = (const int64_t*) (data + _header->_headerSize + parentBytes);
+	_nodes = (const int*) (_offsets + numSubtrees + 1);
+	bool valid = _parent[0] == -1 && _offsets[0] == 0 && _offsets[numSubtrees] == totalSize;
+	for (int v = 1; v < _numHostNodes && valid; ++v)
+		valid = _parent[v] >= 0 && _parent[v] < v;
+	for (int i = 0; i < _numSubtrees && valid; ++i)
+		valid = _offsets[i] < _offsets[i + 1];
+	for (int i = 0; i < _numSubtrees && valid; ++i) {
+		for (int64_t k = _offsets[i]; k < _offsets[i + 1] && valid; ++k)
+			valid = _nodes[k] >= 0 && _nodes[k] < _numHostNodes && (k == _offsets[i] || _nodes[k - 1] < _nodes[k]); //sorted for Adjacent
+	}
+	if (!valid) {
+		cout << fileName << " is truncated or corrupt!" << endl;
+		return false;
+	}
+	return true;
+}
+
+/*
+ * the top node of a subtree is its node of the smallest depth; both indices are filled by a counting pass and a fill pass
+ */
+void IntersectionModel::BuildIndex() {
+	vector<int> depth(_numHostNodes, 0);
+	for (int v = 1; v < _numHostNodes; ++v)
+		depth[v] = depth[_parent[v]] + 1;
+	_top.resize(_numSubtrees);
+	_coverOffsets.assign(_numHostNodes + 1, 0);
+	_topOffsets.assign(_numHostNodes + 1, 0);
+	for (int i = 0; i < _numSubtrees; ++i) {
+		int top = _nodes[_offsets[i]];
+		for (int64_t k = _offsets[i]; k < _offsets[i + 1]; ++k) {
+			_coverOffsets[_nodes[k] + 1]++;
+			if (depth[_nodes[k]] < depth[top]) top = _nodes[k];
+		}
+		_top[i] = top;
+		_topOffsets[top + 1]++;
+	}
+	for (int x = 0; x < _numHostNodes; ++x) {
+		_coverOffsets[x + 1] += _coverOffsets[x];
+		_topOffsets[x + 1] += _topOffsets[x];
+	}
+	_covering.resize(_coverOffsets[_numHostNodes]);
+	_byTop.resize(_numSubtrees);
+	vector<long long> coverPosition(_coverOffsets.begin(), _coverOffsets.end() - 1);
+	vector<int> topPosition(_topOffsets.begin(), _topOffsets.end() - 1);
+	for (int i = 0; i < _numSubtrees; ++i) {
+		for (int64_t k = _offsets[i]; k < _offsets[i + 1]; ++k)
+			_covering[coverPosition[_nodes[k]]++] = i;
+		_byTop[topPosition[_top[i]]++] = i;
+	}
+}
+
+void IntersectionModel::Close() {
+	_file.Close();
+	_header = NULL;
+	_parent = NULL;
+	_offsets = NULL;
+	_nodes = NULL;
+	_numHostNodes = _numSubtrees = 0;
+	vector<int>().swap(_top);
+	vector<long long>().swap(_coverOffsets);
+	vector<int>().swap(_covering);
+	vector<int>().swap(_topOffsets);
+	vector<int>().swap(_byTop);
+}
+
+/*
+ * two binary searches in the sorted subtrees
+ */
+bool IntersectionModel::Adjacent(int u, int v) const {
+	if (u == v) return false;
+	return binary_search(_nodes + _offsets[v], _nodes + _offsets[v + 1], _top[u])
+		|| binary_search(_nodes + _offsets[u], _nodes + _offsets[u + 1], _top[v]);
+}
+
+/*
+ * the subtrees containing the top node of u (u itself among them), and the subtrees whose top node is another node of u; the two
+ * groups are disjoint, since a subtree of the second group containing the top node of u would have it as its top node
+ */
+int IntersectionModel::GetDegree(int u) const {
+	int top = _top[u];
+	long long degree = _coverOffsets[top + 1] - _coverOffsets[top] - 1;
+	for (int64_t k = _offsets[u]; k < _offsets[u + 1]; ++k) {
+		if (_nodes[k] != top) degree += _topOffsets[_nodes[k] + 1] - _topOffsets[_nodes[k]];
+	}
+	return (int) degree;
+}
+
+/*
+ * the neighbours of u in no particular order, in O(|subtree u| + degree) time
+ */
+void IntersectionModel::FindNeighbours(int u, vector<int>& neighbours) const {
+	neighbours.clear();
+	int top = _top[u];
+	for (long long k = _coverOffsets[top]; k < _coverOffsets[top + 1]; ++k) {
+		if (_covering[k] != u) neighbours.push_back(_covering[k]);
+	}
+	for (int64_t k = _offsets[u]; k < _offsets[u + 1]; ++k) {
+		int x = _nodes[k];
+		if (x != top) neighbours.insert(neighbours.end(), _byTop.begin() + _topOffsets[x], _byTop.begin() + _topOffsets[x + 1]);
+	}
+}
+
+/*
+ * the edges (u,v), u<v, in ascending order, one node at a time, so the edge list is never stored
+ */
+void IntersectionModel::ExpandTo(EdgeSink& sink) const {
+	vector<int> neighbours;
+	sink.Begin(_numSubtrees);
+	for (int u = 0; u < _numSubtrees; ++u) {
+		FindNeighbours(u, neighbours);
+		neighbours.erase(remove_if(neighbours.begin(), neighbours.end(), [u](int v) { return v < u; }), neighbours.end());
+		sort(neighbours.begin(), neighbours.end());
+		for (size_t k = 0; k < neighbours.size(); ++k)
+			sink.AddEdge(u, neighbours[k]);
+	}
+	sink.End();
+}
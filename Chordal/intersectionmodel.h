@@ -0,0 +1,68 @@
+#ifndef INTERSECTIONMODEL_H_
+#define INTERSECTIONMODEL_H_
+
+#include "common.h"
+#include "mappedfile.h"
+#include "edgesink.h"
+#include <stdint.h>
+
+class Tree;
+
+#define INTERSECTION_MODEL_MAGIC "CHRDMDL"          //7 characters and the terminating zero
+#define INTERSECTION_MODEL_VERSION 1
+#define INTERSECTION_MODEL_BYTE_ORDER 0x01020304u
+
+/*
+ * the file is this header, then the parents of the host tree nodes as int32 (parent[0] = -1 and parent[v] < v), padded to a multiple
+ * of 8 bytes, the (numSubtrees+1) subtree offsets as int64 and the subtree nodes as int32, the nodes of subtree i being
+ * nodes[offsets[i]] ... nodes[offsets[i+1]-1] in ascending order; subtree i is node i of the graph
+ */
+struct IntersectionModelHeader {
+	char _magic[8];
+	uint32_t _version;
+	uint32_t _byteOrder;
+	uint32_t _headerSize;                   //bytes before the parents
+	uint32_t _reserved;
+	int64_t _numHostNodes;
+	int64_t _numSubtrees;
+	int64_t _totalSubtreeSize;
+	int64_t _numEdges;                      //of the intersection graph
+	char _method[8];                        //gs, cn or pt
+	double _params[4];                      //method-specific params in the order of the command line, -1 if unused
+};
+
+/*
+ * the intersection graph of the subtrees of a tree, given by the tree and the subtrees instead of its edges. Two subtrees
+ * intersect iff the top node (the one closest to the root) of one of them is in the other, so the graph is queried through
+ * two indices of size O(n + sum of subtree sizes): the subtrees containing each host node and the subtrees by their top nodes
+ */
+class IntersectionModel {
+public:
+	IntersectionModel() : _header(NULL), _parent(NULL), _offsets(NULL), _nodes(NULL), _numHostNodes(0), _numSubtrees(0) {}
+	static bool Write(string fileName, const Tree& tree, string method, const vector<double>& params);
+	bool Open(string fileName);
+	void Close();
+	const IntersectionModelHeader& GetHeader() const { return *_header; }
+	int GetNumNodes() const { return _numSubtrees; }
+	long long GetNumEdges() const { return _header->_numEdges; }
+	bool Adjacent(int u, int v) const;
+	int GetDegree(int u) const;
+	void FindNeighbours(int u, vector<int>& neighbours) const;
+	void ExpandTo(EdgeSink& sink) const;
+
+private:
+	MappedFile _file;
+	const IntersectionModelHeader* _header;
+	const int* _parent;
+	const int64_t* _offsets;
+	const int* _nodes;
+	int _numHostNodes, _numSubtrees;
+	vector<int> _top;                       //top node of each subtree
+	vector<long long> _coverOffsets;        //subtrees containing host node x: _covering[_coverOffsets[x]] ... _covering[_coverOffsets[x+1]-1]
+	vector<int> _covering;
+	vector<int> _topOffsets, _byTop;        //subtrees whose top node is x: _byTop[_topOffsets[x]] ... _byTop[_topOffsets[x+1]-1]
+	bool Validate(string fileName);
+	void BuildIndex();
+};
+
+#endif
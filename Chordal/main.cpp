@@ -1,141 +1,757 @@
-#include "chordal.h"
-
-#ifdef _WIN32
-#include <windows.h>
-#include <direct.h>
-#define mkdir(a,b) _mkdir(a)
-#define DIRECTORY_SEPARATOR "\\"
-#else
-#include <unistd.h>
-#include <sys/stat.h>
-#include <sys/types.h>
-#define DIRECTORY_SEPARATOR "/"
-#endif
-
-#define OUT_BASE_DIR "C:\\Users\\TheUser\\Desktop\\"
-#define MAIN_FOLDER "ChordalGraphs"
-#define INSTANCE_INFO_FILE_NAME "instance_info.csv"
-#define CLIQUE_SIZE_INFO_FILE_NAME	"clique_size_frequencies.csv"
-
-string method;				// Parameter #1: Subtree generation method (gs, cn, pt, or peo)
-int n;						// Parameter #2: Number of vertices
-
-int maxSubtreeSize;			// Parameter #3 (gs): Maximum subtree size for the growingSUbtree method
-
-double thresholdProb;		// Parameter #3 (cn): Threshold probability value for the connectingNodes method
-
-double edgeDelPerc;			// Parameter #3 (pt): Edge deletion percentage for the prunedTree method
-double barrier;				// Parameter #4 (pt): Selection barrier quantile for subtree selection in the prunedTree method
-
-double upperBoundCoef;		// Parameter #3 (peo): "Upper bound coefficient" parameter (used in Seker et al. (2018)) for the peo-based method of Andreou et al. (2005)
-
-char *graphIndex;           // Parameter #4/5: The index of the graph
-
-
-static ChordalGenerationParams readArguments(int argc, char ** argv) {
-	if (argc < 5 || argc > 6) {
-		cerr << "Usage: " << argv[0] << " chordal_gen_method number_of_vertices method_specific_param(s) graph_index" << endl;
-		cerr << "Options for chordal graph generation method: \n" << "gs: growingSubtree \n" << "cs: connectingNodes \n" << "pt: prunedTree \n" << "peo: peoBased" << endl;
-		cerr << "growingSubtree-specific params: max_subtree_size (integer between 1 and number_of_vertices" << endl;
-		cerr << "connectingNodes-specific params: node_sel_prob_param (double in (0,1])" << endl;
-		cerr << "prunedTree-specific params: edge_deletion_perc (double in [0,1)) and selection_barrier (double in [0,1))" << endl;
-		cerr << "prunedTree-specific params: edge_deletion_perc (double in [0,1)) and selection_barrier (double in [0,1))" << endl;
-		cerr << "peoBased-specific params: upper_bound_coef (double in (0,1]), the larger its value the higher the density tends to" << endl;
-		
-		system("pause");
-
-		exit(EXIT_FAILURE);
-	}
-
-	method = argv[1];
-
-	ChordalGenerationParams params(method);
-	
-	if (method == "gs" || method == "cn" || method == "pt" || method == "peo") {
-		
-		n = stoi(argv[2]);
-		params._numNodes = n;
-
-		if (n < 1)	{
-			cout << "n should be a positive integer!" << endl;
-			exit(EXIT_FAILURE);
-		}
-		if (method == "gs") {
-			maxSubtreeSize = stoi(argv[3]);
-			if (maxSubtreeSize < 1) {
-				cout << "max_subtree_size should be a positive integer!" << endl;
-				exit(EXIT_FAILURE);
-			}
-			params._maxSubtreeSize = maxSubtreeSize;
-			graphIndex = argv[4];
-		} else if (method == "cn") {
-			thresholdProb = stod(argv[3]);
-			if (thresholdProb > 1 || thresholdProb <= 0) {
-				cout << "node_sel_prob_param should be in (0,1]!" << endl;
-				exit(EXIT_FAILURE);
-			}
-			params._thresholdProb = thresholdProb;
-			graphIndex = argv[4];
-		} else if (method == "pt") {
-			edgeDelPerc = stod(argv[3]);
-			barrier = stod(argv[4]);
-			if (edgeDelPerc >= 1 || edgeDelPerc < 0) {
-				cout << "edge_deletion_perc should be in [0,1)!" << endl;
-				exit(EXIT_FAILURE);
-			}
-			if (barrier >= 1 || barrier < 0) {
-				cout << "selection_barrier should be in [0,1)!" << endl;
-				exit(EXIT_FAILURE);
-			}
-			params._edgeDelPerc = edgeDelPerc;
-			params._barrier = barrier;
-			graphIndex = argv[5];
-		} else if (method == "peo") {
-			upperBoundCoef = stod(argv[3]);
-			if (upperBoundCoef > 1 || upperBoundCoef <= 0) {
-				cout << "upper_bound_coef should be in (0,1]!" << endl;
-				exit(EXIT_FAILURE);
-			}
-			params._upperBoundCoef = upperBoundCoef;
-			graphIndex = argv[4];
-		}
-	} else {
-		cout << "Invalid method selection. Select 'gs', 'cn', 'pt', or 'peo'." << endl;
-		exit(EXIT_FAILURE);
-	}
-
-	return params;
-}
-
-
-int main(int argc, char *argv[]) {
-	cout << "Starting to read arguments..." << endl;
-	ChordalGenerationParams params = readArguments(argc, argv);
-	cout << "Finished reading arguments..." << endl;
-	
-	ChordalGraph* pchg;
-	pchg = new ChordalGraph(params);
-	string methodFolder = params._method;
-	pchg->Build();
-
-	// Write graph to file (in LEMON's graph format .lgf)
-	string mainFolder = MAIN_FOLDER;
-	string outDir = OUT_BASE_DIR + mainFolder;
-	mkdir(outDir.c_str(), 0777);
-	string outDirMethod = outDir + DIRECTORY_SEPARATOR + methodFolder + DIRECTORY_SEPARATOR;
-	mkdir(outDirMethod.c_str(), 0777);
-	string outDirInst = outDirMethod + to_string(n) + DIRECTORY_SEPARATOR;
-	mkdir(outDirInst.c_str(), 0777);
-	string fileName = outDirInst + "chordalgr_" + to_string(n) + "_" + graphIndex + ".lgf";
-	pchg->WriteGraphToFile(fileName);
-
-	// Write instance stats to file
-	string instanceInfoFileName = outDirMethod;
-	instanceInfoFileName = instanceInfoFileName + DIRECTORY_SEPARATOR + INSTANCE_INFO_FILE_NAME;
-	string cliqueSizeInfoFileName = outDirMethod;
-	cliqueSizeInfoFileName = cliqueSizeInfoFileName + DIRECTORY_SEPARATOR + CLIQUE_SIZE_INFO_FILE_NAME;
-	pchg->CollectAndWriteStats(fileName, instanceInfoFileName, cliqueSizeInfoFileName);
-
-	delete pchg; 
-
-}
+#include "chordal.h"
+#include "binarygraph.h"
+#include "intersectionmodel.h"
+#include "stats.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <direct.h>
+#define mkdir(a,b) _mkdir(a)
+#define DIRECTORY_SEPARATOR "\\"
+#else
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#define DIRECTORY_SEPARATOR "/"
+#endif
+
+#define OUT_BASE_DIR "C:\\Users\\TheUser\\Desktop\\"
+#define MAIN_FOLDER "ChordalGraphs"
+#define INSTANCE_INFO_FILE_NAME "instance_info.csv"
+#define CLIQUE_SIZE_INFO_FILE_NAME	"clique_size_frequencies.csv"
+#define BENCHMARK_FILE_NAME "benchmark.csv"
+#define BENCHMARK_GRAPH_FILE_NAME "benchmark_graph"	// written and removed by every case of the benchmark
+#define BENCHMARK_SEED 20181001						// default seed of the benchmark, so that its runs are comparable
+#define BENCHMARK_MIN_N 1000
+#define BENCHMARK_MAX_N 1000000
+#define BENCHMARK_MAX_EDGES 100000000LL
+#define BENCHMARK_REFERENCE_N 1000						// the params of the benchmark cases are given for this n
+
+string method;				// Parameter #1: Subtree generation method (gs, cn, pt, or peo)
+int n;						// Parameter #2: Number of vertices
+
+int maxSubtreeSize;			// Parameter #3 (gs): Maximum subtree size for the growingSUbtree method
+
+double thresholdProb;		// Parameter #3 (cn): Threshold probability value for the connectingNodes method
+
+double edgeDelPerc;			// Parameter #3 (pt): Edge deletion percentage for the prunedTree method
+double barrier;				// Parameter #4 (pt): Selection barrier quantile for subtree selection in the prunedTree method
+
+double upperBoundCoef;		// Parameter #3 (peo): "Upper bound coefficient" parameter (used in Seker et al. (2018)) for the peo-based method of Andreou et al. (2005)
+
+char *graphIndex;           // Parameter #4/5: The index of the graph
+
+string intersectionMode = "auto";	// Option --intersection: Construction of the subtree intersection graph (pairwise, index, bitset, or auto)
+int numThreads = 1;					// Option --threads: Number of threads for the subtree intersection graph construction, or of the workers in batch/stats mode (0: all cores)
+string peoAdjacency = "auto";		// Option --peo-adjacency: Adjacency structure of the peo-based method (sparse, bitmatrix, or auto)
+bool streamEdges = false;			// Option --stream (no value): Write the edges while they are generated, without storing the graph
+string outputFormat = "lgf";		// Option --format: Format of the graph file (lgf, bin, both, or model)
+uint64_t seed = 0;					// Option --seed: Seed of the random streams of the instances (default: from random_device)
+bool seedGiven = false;
+bool writeCliqueTree = false;		// Option --clique-tree (no value): Write the clique tree of every graph to a .td file next to it
+bool verifyChordality = false;		// Option --verify (no value): Check that every graph is chordal by verifying the ordering found by MCS
+double targetDensity = -1;			// Option --target-density: Density the param of the method is calibrated to (the param is ignored then)
+bool estimateOnly = false;			// Option --estimate (no value): Only estimate the number of edges, the density and the memory of the instance
+
+
+/*
+ * options are given as "--name value" pairs (or as "--name" for flags) anywhere on the command line; they are removed from argv
+ * so that the positional parameters keep their places
+ */
+static void readOptions(int& argc, char ** argv) {
+	int numPositional = 1;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg.compare(0, 2, "--") != 0) {
+			argv[numPositional++] = argv[i];
+			continue;
+		}
+		if (arg == "--stream") {
+			streamEdges = true;
+			continue;
+		}
+		if (arg == "--estimate") {
+			estimateOnly = true;
+			continue;
+		}
+		if (arg == "--clique-tree") {
+			writeCliqueTree = true;
+			continue;
+		}
+		if (arg == "--verify") {
+			verifyChordality = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			cout << "Option " << arg << " needs a value!" << endl;
+			exit(EXIT_FAILURE);
+		}
+		string value = argv[++i];
+		if (arg == "--intersection") {
+			if (value != "pairwise" && value != "index" && value != "bitset" && value != "auto") {
+				cout << "--intersection should be 'pairwise', 'index', 'bitset', or 'auto'!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			intersectionMode = value;
+		} else if (arg == "--threads") {
+			numThreads = stoi(value);
+			if (numThreads < 0) {
+				cout << "--threads should be a nonnegative integer!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			if (numThreads == 0)
+				numThreads = max(1, (int) thread::hardware_concurrency());
+		} else if (arg == "--peo-adjacency") {
+			if (value != "sparse" && value != "bitmatrix" && value != "auto") {
+				cout << "--peo-adjacency should be 'sparse', 'bitmatrix', or 'auto'!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			peoAdjacency = value;
+		} else if (arg == "--seed") {
+			seed = stoull(value);
+			seedGiven = true;
+		} else if (arg == "--target-density") {
+			targetDensity = stod(value);
+			if (targetDensity <= 0 || targetDensity > 1) {
+				cout << "--target-density should be in (0,1]!" << endl;
+				exit(EXIT_FAILURE);
+			}
+		} else if (arg == "--format") {
+			if (value != "lgf" && value != "bin" && value != "both" && value != "model") {
+				cout << "--format should be 'lgf', 'bin', 'both', or 'model'!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			outputFormat = value;
+		} else {
+			cout << "Unknown option " << arg << "!" << endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+	if (!seedGiven) {
+		seed = SeedFromDevice();
+		seedGiven = true;
+	}
+	if (streamEdges && outputFormat != "lgf") {
+		// the offsets of the binary format precede the neighbours, so the whole graph is needed before writing
+		cout << "--stream can only be used with --format lgf!" << endl;
+		exit(EXIT_FAILURE);
+	}
+	if ((writeCliqueTree || verifyChordality) && (streamEdges || outputFormat == "model")) {
+		// the clique tree and the ordering to be verified are found by MCS on the stored graph
+		cout << "--clique-tree and --verify cannot be used with --stream or --format model!" << endl;
+		exit(EXIT_FAILURE);
+	}
+	if (estimateOnly && numPositional > 1 && (string(argv[1]) == "stats" || string(argv[1]) == "batch" || string(argv[1]) == "bench")) {
+		cout << "--estimate can only be used for a single instance!" << endl;
+		exit(EXIT_FAILURE);
+	}
+	argc = numPositional;
+}
+
+
+static ChordalGenerationParams readInstanceArguments(char ** argv);
+
+/*
+ * the random stream of an instance is keyed by its arguments (as written), so it does not depend on the mode, the thread or the
+ * other instances
+ */
+static uint64_t instanceStream(char ** argv) {
+	string method = argv[1];
+	string key = method;
+	for (int i = 2; i <= (method == "pt" ? 5 : 4); ++i)
+		key = key + " " + argv[i];
+	return HashStreamKey(key);
+}
+
+static ChordalGenerationParams readArguments(int argc, char ** argv) {
+	readOptions(argc, argv);
+	if (argc < 5 || argc > 6) {
+		cerr << "Usage: " << argv[0] << " chordal_gen_method number_of_vertices method_specific_param(s) graph_index [options]" << endl;
+		cerr << "Options for chordal graph generation method: \n" << "gs: growingSubtree \n" << "cs: connectingNodes \n" << "pt: prunedTree \n" << "peo: peoBased" << endl;
+		cerr << "growingSubtree-specific params: max_subtree_size (integer between 1 and number_of_vertices" << endl;
+		cerr << "connectingNodes-specific params: node_sel_prob_param (double in (0,1])" << endl;
+		cerr << "prunedTree-specific params: edge_deletion_perc (double in [0,1)) and selection_barrier (double in [0,1))" << endl;
+		cerr << "prunedTree-specific params: edge_deletion_perc (double in [0,1)) and selection_barrier (double in [0,1))" << endl;
+		cerr << "peoBased-specific params: upper_bound_coef (double in (0,1]), the larger its value the higher the density tends to" << endl;
+		cerr << "Options: --intersection pairwise|index|bitset|auto (intersection graph construction of gs, cn and pt, default: auto)" << endl;
+		cerr << "         --threads number_of_threads (for the intersection graph construction, or instances/files processed at once in batch/stats mode, 0: all cores, default: 1)" << endl;
+		cerr << "         --peo-adjacency sparse|bitmatrix|auto (adjacency structure of peoBased, default: auto)" << endl;
+		cerr << "         --stream (write the edges while they are generated; the clique statistics of peo are not calculated then)" << endl;
+		cerr << "         --format lgf|bin|both|model (LEMON's .lgf text, memory-mappable binary .bin in CSR form, both of them, or" << endl;
+		cerr << "                  the host tree and the subtrees of gs, cn and pt in a binary .mdl file without the edges, default: lgf)" << endl;
+		cerr << "         --seed seed (an instance is reproduced by the same seed and arguments, also in batch mode, default: random)" << endl;
+		cerr << "         --clique-tree (also write the clique tree in PACE's tree decomposition format .td next to the graph file)" << endl;
+		cerr << "         --verify (check that the graph is chordal by verifying a perfect elimination ordering in linear time)" << endl;
+		cerr << "         --target-density density (calibrate max_subtree_size, node_sel_prob_param, edge_deletion_perc or upper_bound_coef" << endl;
+		cerr << "                  to the density before generating; write auto in its place)" << endl;
+		cerr << "         --estimate (only print the number of edges, exact for gs, cn and pt, the density and the memory of the build," << endl;
+		cerr << "                  without generating the graph or writing any files)" << endl;
+		cerr << "Recomputing the statistics of existing graph files: " << argv[0] << " stats graph_file(s) [--threads number_of_threads] [--clique-tree] [--verify]" << endl;
+		cerr << "Generating the instances of a manifest concurrently: " << argv[0] << " batch manifest_file [--threads number_of_threads] [options]" << endl;
+		cerr << "Benchmarking all methods over sizes and densities: " << argv[0] << " bench [min_n [max_n [max_edges]]] [options]" << endl;
+		
+		system("pause");
+
+		exit(EXIT_FAILURE);
+	}
+
+	return readInstanceArguments(argv);
+}
+
+
+/*
+ * argv[1], argv[2], ... are the method, the number of vertices, the method-specific param(s) and the graph index
+ */
+static ChordalGenerationParams readInstanceArguments(char ** argv) {
+	method = argv[1];
+
+	ChordalGenerationParams params(method);
+	params._intersectionMode = intersectionMode;
+	params._numThreads = numThreads;
+	params._peoAdjacency = peoAdjacency;
+	params._seed = seed;
+	
+	if (method == "gs" || method == "cn" || method == "pt" || method == "peo") {
+		
+		n = stoi(argv[2]);
+		params._numNodes = n;
+
+		if (n < 1)	{
+			cout << "n should be a positive integer!" << endl;
+			exit(EXIT_FAILURE);
+		}
+		// with --target-density the first method-specific param is calibrated later, so it is not read
+		bool calibrated = targetDensity > 0;
+		if (method == "gs") {
+			maxSubtreeSize = calibrated ? 1 : stoi(argv[3]);
+			if (maxSubtreeSize < 1) {
+				cout << "max_subtree_size should be a positive integer!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			params._maxSubtreeSize = maxSubtreeSize;
+			graphIndex = argv[4];
+		} else if (method == "cn") {
+			thresholdProb = calibrated ? 1 : stod(argv[3]);
+			if (thresholdProb > 1 || thresholdProb <= 0) {
+				cout << "node_sel_prob_param should be in (0,1]!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			params._thresholdProb = thresholdProb;
+			graphIndex = argv[4];
+		} else if (method == "pt") {
+			edgeDelPerc = calibrated ? 0 : stod(argv[3]);
+			barrier = stod(argv[4]);
+			if (edgeDelPerc >= 1 || edgeDelPerc < 0) {
+				cout << "edge_deletion_perc should be in [0,1)!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			if (barrier >= 1 || barrier < 0) {
+				cout << "selection_barrier should be in [0,1)!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			params._edgeDelPerc = edgeDelPerc;
+			params._barrier = barrier;
+			graphIndex = argv[5];
+		} else if (method == "peo") {
+			upperBoundCoef = calibrated ? 1 : stod(argv[3]);
+			if (upperBoundCoef > 1 || upperBoundCoef <= 0) {
+				cout << "upper_bound_coef should be in (0,1]!" << endl;
+				exit(EXIT_FAILURE);
+			}
+			params._upperBoundCoef = upperBoundCoef;
+			graphIndex = argv[4];
+		}
+	} else {
+		cout << "Invalid method selection. Select 'gs', 'cn', 'pt', or 'peo'." << endl;
+		exit(EXIT_FAILURE);
+	}
+	if (outputFormat == "model" && method == "peo") {
+		cout << "--format model is only for the subtree intersection methods (gs, cn, and pt)!" << endl;
+		exit(EXIT_FAILURE);
+	}
+	params._stream = instanceStream(argv);
+
+	return params;
+}
+
+
+/*
+ * creates the directories of the instance (ChordalGraphs/<method>/<n>/), sets outDirMethod and returns the file name without extension
+ */
+static string makeInstanceDirectories(string methodFolder, int numNodes, string index, string& outDirMethod) {
+	string mainFolder = MAIN_FOLDER;
+	string outDir = OUT_BASE_DIR + mainFolder;
+	mkdir(outDir.c_str(), 0777);
+	outDirMethod = outDir + DIRECTORY_SEPARATOR + methodFolder + DIRECTORY_SEPARATOR;
+	mkdir(outDirMethod.c_str(), 0777);
+	string outDirInst = outDirMethod + to_string(numNodes) + DIRECTORY_SEPARATOR;
+	mkdir(outDirInst.c_str(), 0777);
+	return outDirInst + "chordalgr_" + to_string(numNodes) + "_" + index;
+}
+
+/*
+ * builds the graph (after calibrating its param with --target-density) and writes it in the selected format(s); returns the name of the file that goes into the csv files,
+ * or "" if the graph could not be written (the error is reported, but the process is not ended, since other instances may be running)
+ */
+static string buildAndWriteGraph(ChordalGraph& chg, string fileNameBase) {
+	if (targetDensity > 0)
+		chg.CalibrateDensity(targetDensity);
+	string fileName = fileNameBase + (outputFormat == "bin" ? ".bin" : outputFormat == "model" ? ".mdl" : ".lgf");
+	if (outputFormat == "model") {
+		// Write the intersection model (host tree and subtrees) instead of the edges
+		chg.BuildModel();
+		if (!chg.WriteModelToFile(fileName))
+			return "";
+	} else if (streamEdges) {
+		// Write graph to file (in LEMON's graph format .lgf) while it is generated
+		LGFWriterSink writer(fileName);
+		chg.Build(writer);
+		if (!writer.Succeeded())
+			return "";
+	} else {
+		chg.Build();
+		// Write graph to file (in LEMON's graph format .lgf and/or in the binary format .bin)
+		if (outputFormat != "bin" && !chg.WriteGraphToFile(fileNameBase + ".lgf"))
+			return "";
+		if (outputFormat != "lgf" && !chg.WriteBinaryGraphToFile(fileNameBase + ".bin"))
+			return "";
+	}
+	return fileName;
+}
+
+/*
+ * estimate mode: the number of edges, the density and the peak memory of the build (stored and streamed) of the instance, in the
+ * time of its subtrees for gs, cn and pt, or of a pilot run for peo
+ */
+static void estimateInstance(ChordalGraph& chg, int numNodes) {
+	if (targetDensity > 0)
+		chg.CalibrateDensity(targetDensity);
+	long long lowerBound;
+	long long numEdges = chg.EstimateNumEdges(lowerBound);
+	double density = numNodes > 1 ? numEdges / (double(numNodes)*(numNodes - 1) / 2) : 0;
+	bool exact = (method != "peo");
+	cout << "A chordal graph with " << numNodes << " nodes would have " << (exact ? "exactly " : "about ") << numEdges << " edges";
+	if (!exact) cout << " (at least " << lowerBound << ")";
+	cout << " and " << density << " density (estimated in " << chg.GetBuildTime() << " s)." << endl;
+	cout << "Its build would take about " << chg.EstimateMemory(numEdges, false) / 1048576 << " MB of memory, "
+		<< chg.EstimateMemory(numEdges, true) / 1048576 << " MB with --stream." << endl;
+}
+
+/*
+ * runs job(i, ...) for i = 0 ... numJobs-1 on numWorkers threads, and passes the two rows each job produces to write(i, ...) on this
+ * thread in the order of i, as soon as all earlier jobs are done
+ */
+typedef function<void(int, string&, string&)> Job;
+typedef function<void(int, const string&, const string&)> RowWriter;
+static void processInOrder(int numJobs, int numWorkers, const Job& job, const RowWriter& write) {
+	vector<string> rows1(numJobs), rows2(numJobs);
+	vector<char> done(numJobs, 0);
+	atomic<int> nextJob(0);
+	mutex doneMutex;
+	condition_variable doneCondition;
+	auto work = [&]() {
+		for (int i = nextJob++; i < numJobs; i = nextJob++) {
+			string row1, row2;
+			job(i, row1, row2);
+			lock_guard<mutex> lock(doneMutex);
+			rows1[i].swap(row1);
+			rows2[i].swap(row2);
+			done[i] = 1;
+			doneCondition.notify_one();
+		}
+	};
+	vector<thread> workers;
+	for (int t = 0; t < min(numWorkers, numJobs); ++t)
+		workers.push_back(thread(work));
+
+	for (int i = 0; i < numJobs; ++i) {
+		string row1, row2;
+		{
+			unique_lock<mutex> lock(doneMutex);
+			doneCondition.wait(lock, [&]() { return done[i] != 0; });
+			row1.swap(rows1[i]);
+			row2.swap(rows2[i]);
+		}
+		write(i, row1, row2);
+	}
+	for (size_t t = 0; t < workers.size(); ++t)
+		workers[t].join();
+}
+
+
+/*
+ * the method is the name of the directory above the instance directory (ChordalGraphs/<method>/<n>/chordalgr_<n>_<index>.lgf)
+ */
+static string methodFromPath(string fileName) {
+	vector<string> directories;
+	size_t begin = 0;
+	for (size_t pos = fileName.find_first_of("/\\"); pos != string::npos; pos = fileName.find_first_of("/\\", begin)) {
+		directories.push_back(fileName.substr(begin, pos - begin));
+		begin = pos + 1;
+	}
+	if (directories.size() < 2) return "";
+	string method = directories[directories.size() - 2];
+	return method == "gs" || method == "cn" || method == "pt" || method == "peo" ? method : "";
+}
+
+/*
+ * the statistics of a graph file (.bin, .mdl or .lgf) as its rows of instance_info.csv and clique_size_frequencies.csv;
+ * the method and its params come from the header of a .bin or .mdl file, only the method is known for an .lgf file (from its path)
+ * and the generation time is unknown for both (only the time of the statistics is measured); isChordal is only set with --verify
+ */
+static bool recomputeStatsOfFile(string fileName, string& instanceInfo, string& cliqueSizeInfo, bool& isChordal) {
+	CSRGraph g;
+	string method;
+	vector<double> params;
+	if (fileName.size() > 4 && fileName.compare(fileName.size() - 4, 4, ".bin") == 0) {
+		BinaryGraphFile file;
+		if (!file.Open(fileName)) return false;
+		file.CopyTo(g);
+		const BinaryGraphHeader& header = file.GetHeader();
+		method = string(header._method, strnlen(header._method, sizeof(header._method)));
+		params.assign(header._params, header._params + 4);
+	} else if (fileName.size() > 4 && fileName.compare(fileName.size() - 4, 4, ".mdl") == 0) {
+		IntersectionModel model;
+		if (!model.Open(fileName)) return false;
+		GraphBuilderSink builder(g);
+		model.ExpandTo(builder);
+		const IntersectionModelHeader& header = model.GetHeader();
+		method = string(header._method, strnlen(header._method, sizeof(header._method)));
+		params.assign(header._params, header._params + 4);
+	} else {
+		if (!g.ReadLGF(fileName)) return false;
+		method = methodFromPath(fileName);
+	}
+	PhaseTimes times;
+	TimePoint begin = chrono::steady_clock::now();
+	Stats stats(g);
+	stats.CalculateStats(writeCliqueTree);
+	if (writeCliqueTree)
+		stats.WriteCliqueTree(fileName.substr(0, fileName.find_last_of('.')) + ".td");
+	if (verifyChordality) {
+		ostringstream report;
+		isChordal = stats.VerifyPEO(report, fileName);
+		cout << report.str();
+	}
+	times.Add(PHASE_STATS, ScopedTimer::SecondsSince(begin));
+	ostringstream instanceInfoRow, cliqueSizeInfoRow;
+	stats.WriteInstanceInfo(instanceInfoRow, fileName, Stats::MethodColumns(method, params), "," + times.Columns());
+	stats.WriteCliqueSizeFrequencies(cliqueSizeInfoRow, fileName);
+	instanceInfo = instanceInfoRow.str();
+	cliqueSizeInfo = cliqueSizeInfoRow.str();
+	return true;
+}
+
+/*
+ * stats mode: the files are processed by numThreads workers, and their rows are appended to the csv files of the current
+ * directory in the order of the files; returns the number of files that could not be read or were found not to be chordal (with --verify)
+ */
+static int recomputeStats(int numFiles, char** fileNames) {
+	atomic<int> numNotChordal(0), numSkipped(0);
+	ofstream file, file2;
+	file.open(INSTANCE_INFO_FILE_NAME, ios::out | ios::ate | ios::app);
+	file2.open(CLIQUE_SIZE_INFO_FILE_NAME, ios::out | ios::ate | ios::app);
+	processInOrder(numFiles, numThreads,
+		[&](int i, string& instanceInfo, string& cliqueSizeInfo) {
+			bool isChordal = true;
+			if (!recomputeStatsOfFile(fileNames[i], instanceInfo, cliqueSizeInfo, isChordal)) {
+				cout << "Skipping " << fileNames[i] << endl;
+				numSkipped++;
+			}
+			if (!isChordal) numNotChordal++;
+		},
+		[&](int, const string& instanceInfo, const string& cliqueSizeInfo) {
+			file << instanceInfo;
+			file2 << cliqueSizeInfo;
+			file.flush();
+			file2.flush();
+		});
+	file.close();
+	file2.close();
+	cout << "The statistics of " << numFiles - numSkipped << " graphs are written to " << INSTANCE_INFO_FILE_NAME << " and " << CLIQUE_SIZE_INFO_FILE_NAME;
+	if (numSkipped > 0) cout << ", " << numSkipped << " files are skipped";
+	cout << "." << endl;
+	return numNotChordal + numSkipped;
+}
+
+
+class BatchInstance {
+public:
+	ChordalGenerationParams _params;
+	string _fileNameBase;
+	string _outDirMethod;
+
+	BatchInstance(ChordalGenerationParams params) : _params(params) {}
+};
+
+/*
+ * every line of the manifest is "method number_of_vertices method_specific_param(s) first_index[-last_index]" as on the command line
+ * of a single instance, with a range of graph indices; empty lines and lines starting with # are skipped
+ */
+static vector<BatchInstance> readManifest(string manifestFileName) {
+	ifstream manifest(manifestFileName);
+	if (!manifest) {
+		cout << "Cannot open " << manifestFileName << "!" << endl;
+		exit(EXIT_FAILURE);
+	}
+	vector<BatchInstance> instances;
+	string line;
+	for (int lineNumber = 1; getline(manifest, line); ++lineNumber) {
+		istringstream tokenizer(line);
+		vector<string> tokens(1, "batch");
+		string token;
+		while (tokenizer >> token)
+			tokens.push_back(token);
+		if (tokens.size() == 1 || tokens[1][0] == '#') continue;
+		if ((int) tokens.size() != (tokens[1] == "pt" ? 6 : 5)) {
+			cout << manifestFileName << ", line " << lineNumber << ": wrong number of parameters!" << endl;
+			exit(EXIT_FAILURE);
+		}
+		vector<char*> args;
+		for (size_t i = 0; i < tokens.size(); ++i)
+			args.push_back(&tokens[i][0]);
+		ChordalGenerationParams params = readInstanceArguments(args.data());
+		params._numThreads = 1; //the instances run in parallel instead
+
+		string range = tokens.back();
+		size_t dash = range.find('-', 1);
+		int firstIndex = stoi(range.substr(0, dash));
+		int lastIndex = dash == string::npos ? firstIndex : stoi(range.substr(dash + 1));
+		if (lastIndex < firstIndex) {
+			cout << manifestFileName << ", line " << lineNumber << ": empty index range " << range << "!" << endl;
+			exit(EXIT_FAILURE);
+		}
+		for (int index = firstIndex; index <= lastIndex; ++index) {
+			BatchInstance instance(params);
+			tokens.back() = to_string(index);
+			args.back() = &tokens.back()[0];
+			instance._params._stream = instanceStream(args.data());
+			instance._fileNameBase = makeInstanceDirectories(params._method, params._numNodes, to_string(index), instance._outDirMethod);
+			instances.push_back(instance);
+		}
+	}
+	return instances;
+}
+
+/*
+ * batch mode: the instances are generated by numThreads workers, each instance from its own random stream, and the rows of their
+ * statistics are appended to the csv files of their methods in the order of the manifest; returns the number of instances that could
+ * not be written or were found not to be chordal (with --verify)
+ */
+static int generateBatch(string manifestFileName) {
+	vector<BatchInstance> instances = readManifest(manifestFileName);
+	cout << "Seed: " << seed << endl;
+	int numInstances = (int) instances.size();
+	atomic<int> numNotChordal(0), numFailed(0);
+	processInOrder(numInstances, numThreads,
+		[&](int i, string& instanceInfo, string& cliqueSizeInfo) {
+			ChordalGraph chg(instances[i]._params);
+			string fileName = buildAndWriteGraph(chg, instances[i]._fileNameBase);
+			if (fileName.empty()) {
+				numFailed++;
+				return; //no rows, which the writer below reports
+			}
+			ostringstream instanceInfoRow, cliqueSizeInfoRow;
+			bool isChordal = true;
+			chg.CollectStats(fileName, instanceInfoRow, cliqueSizeInfoRow, writeCliqueTree ? instances[i]._fileNameBase + ".td" : "",
+				verifyChordality ? &isChordal : NULL);
+			if (!isChordal) numNotChordal++;
+			instanceInfo = instanceInfoRow.str();
+			cliqueSizeInfo = cliqueSizeInfoRow.str();
+		},
+		[&](int i, const string& instanceInfo, const string& cliqueSizeInfo) {
+			if (instanceInfo.empty()) {
+				cout << "Instance " << i + 1 << " of " << numInstances << " failed: " << instances[i]._fileNameBase << endl;
+				return;
+			}
+			ofstream file;
+			file.open(instances[i]._outDirMethod + DIRECTORY_SEPARATOR + INSTANCE_INFO_FILE_NAME, ios::out | ios::ate | ios::app);
+			file << instanceInfo;
+			file.close();
+			if (!cliqueSizeInfo.empty()) {
+				ofstream file2;
+				file2.open(instances[i]._outDirMethod + DIRECTORY_SEPARATOR + CLIQUE_SIZE_INFO_FILE_NAME, ios::out | ios::ate | ios::app);
+				file2 << cliqueSizeInfo;
+				file2.close();
+			}
+			cout << "Instance " << i + 1 << " of " << numInstances << " is produced: " << instances[i]._fileNameBase << endl;
+		});
+	if (numFailed > 0)
+		cout << numFailed << " of " << numInstances << " instances could not be written!" << endl;
+	return numNotChordal + numFailed;
+}
+
+
+/*
+ * a method with the params of one density level at n = BENCHMARK_REFERENCE_N, where the densities are about 0.002, 0.06 and 0.5
+ * for gs, 0.01, 0.06 and 0.3 for cn, 0.015, 0.1 and 0.7 for pt, and 0.002, 0.25 and 0.9 for peo. For other n the params are
+ * scaled so that the density changes little, or decreases (see scaleBenchmarkParam)
+ */
+class BenchmarkCase {
+public:
+	string _method;
+	string _level;
+	double _param1, _param2;
+};
+
+static const BenchmarkCase benchmarkCases[] = {
+	{"gs", "low", 2, -1}, {"gs", "medium", 20, -1}, {"gs", "high", 200, -1},
+	{"cn", "low", 0.0005, -1}, {"cn", "medium", 0.001, -1}, {"cn", "high", 0.002, -1},
+	{"pt", "low", 0.95, 0.5}, {"pt", "medium", 0.5, 0.5}, {"pt", "high", 0.1, 0.9},
+	{"peo", "low", 0.001, -1}, {"peo", "medium", 0.005, -1}, {"peo", "high", 0.05, -1}
+};
+
+/*
+ * the max subtree size of gs grows with the square root of n; node_sel_prob_param of cn and upper_bound_coef of peo shrink with 1/n,
+ * which keeps the expected number of nodes connected by a subtree and of the neighbours drawn for a node; pt is not scaled
+ */
+static string scaleBenchmarkParam(string method, double param, long long numNodes) {
+	ostringstream scaled;
+	if (method == "gs") {
+		scaled << max(1LL, llround(param * sqrt(double(numNodes) / BENCHMARK_REFERENCE_N)));
+	} else if (method == "cn" || method == "peo") {
+		scaled << param * BENCHMARK_REFERENCE_N / numNodes;
+	} else {
+		scaled << param;
+	}
+	return scaled.str();
+}
+
+/*
+ * one row of benchmark.csv per instance
+ */
+static void writeBenchmarkRow(ostream& file, const BenchmarkCase& benchmarkCase, const ChordalGraph& chg, int numNodes) {
+	const PhaseTimes& times = chg.GetPhaseTimes();
+	vector<double> params = chg.GetMethodParams();
+	long long numEdges = chg.GetNumEdges();
+	file << benchmarkCase._method << "," << benchmarkCase._level << "," << numNodes << "," << params[0] << ",";
+	if (params.size() > 1) file << params[1];
+	file << "," << seed << "," << numEdges << "," << numEdges / (double(numNodes)*(numNodes - 1) / 2) << "," << chg.GetBuildTime() << ",";
+	for (int phase = 0; phase < NUM_PHASES; ++phase)
+		file << times.Get((Phase) phase) << ",";
+	file << (chg.GetBuildTime() > 0 ? numEdges / chg.GetBuildTime() : 0) << "," << double(GetPeakRSS()) / (1 << 20) << endl;
+}
+
+/*
+ * benchmark mode: every method at every density level for n = minN, 10 minN, ... up to maxN, with a fixed seed, one instance after
+ * the other; the graph goes through the whole pipeline (written in the selected format and removed) and the phase times, the
+ * edges generated per second of the build and the peak memory (reset before each instance on Linux) go to benchmark.csv. A case
+ * stops growing when the edges predicted for the next n from the density at this one exceed maxEdges, as the params are scaled
+ * not to increase the density much
+ */
+static void runBenchmark(int minN, int maxN, long long maxEdges) {
+	ifstream existing(BENCHMARK_FILE_NAME);
+	bool isNew = !existing || existing.peek() == ifstream::traits_type::eof();
+	existing.close();
+	ofstream file(BENCHMARK_FILE_NAME, ios::out | ios::ate | ios::app);
+	if (isNew) {
+		file << "method,level,n,param1,param2,seed,edges,density,timeToBuild,timeOfHostTree,timeOfSubtrees,timeOfEdges,timeOfWrite,";
+		file << "timeOfStats,edgesPerSecond,peakRSSMB" << endl;
+	}
+	cout << "Seed: " << seed << endl;
+	for (const BenchmarkCase& benchmarkCase : benchmarkCases) {
+		for (long long numNodes = minN; numNodes <= maxN; numNodes *= 10) {
+			vector<string> tokens;
+			tokens.push_back("bench");
+			tokens.push_back(benchmarkCase._method);
+			tokens.push_back(to_string(numNodes));
+			tokens.push_back(scaleBenchmarkParam(benchmarkCase._method, benchmarkCase._param1, numNodes));
+			if (benchmarkCase._method == "pt")
+				tokens.push_back(scaleBenchmarkParam(benchmarkCase._method, benchmarkCase._param2, numNodes));
+			tokens.push_back("1");
+			vector<char*> args;
+			for (size_t i = 0; i < tokens.size(); ++i)
+				args.push_back(&tokens[i][0]);
+			ChordalGenerationParams params = readInstanceArguments(args.data());
+
+			ResetPeakRSS();
+			ChordalGraph chg(params);
+			string fileName = buildAndWriteGraph(chg, BENCHMARK_GRAPH_FILE_NAME);
+			if (fileName.empty())
+				exit(EXIT_FAILURE);
+			ostringstream instanceInfoRow, cliqueSizeInfoRow;
+			chg.CollectStats(fileName, instanceInfoRow, cliqueSizeInfoRow);
+			writeBenchmarkRow(file, benchmarkCase, chg, (int) numNodes);
+			file.flush();
+			remove(fileName.c_str());
+			if (outputFormat == "both") remove((string(BENCHMARK_GRAPH_FILE_NAME) + ".bin").c_str());
+			cout << benchmarkCase._method << " " << benchmarkCase._level << " n=" << numNodes << ": " << chg.GetNumEdges() << " edges in "
+				<< chg.GetBuildTime() << " s" << endl;
+
+			double predictedEdges = 100.0 * chg.GetNumEdges(); //at the same density
+			if (numNodes * 10 <= maxN && predictedEdges > maxEdges) {
+				cout << benchmarkCase._method << " " << benchmarkCase._level << ": the next size would have about " << predictedEdges
+					<< " edges, skipping the larger sizes" << endl;
+				break;
+			}
+		}
+	}
+	file.close();
+	cout << "The results are appended to " << BENCHMARK_FILE_NAME << "." << endl;
+}
+
+
+int main(int argc, char *argv[]) {
+	if (argc > 1 && string(argv[1]) == "stats") {
+		readOptions(argc, argv);
+		if (argc < 3) {
+			cerr << "Usage: " << argv[0] << " stats graph_file(s) [--threads number_of_threads] [--clique-tree] [--verify]" << endl;
+			cerr << "Recomputes the rows of " << INSTANCE_INFO_FILE_NAME << " and " << CLIQUE_SIZE_INFO_FILE_NAME << " (in the current directory) from .lgf, .bin or .mdl files" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return recomputeStats(argc - 2, argv + 2) == 0 ? 0 : EXIT_FAILURE;
+	}
+	if (argc > 1 && string(argv[1]) == "bench") {
+		seed = BENCHMARK_SEED;
+		seedGiven = true;
+		readOptions(argc, argv);
+		if (argc > 5) {
+			cerr << "Usage: " << argv[0] << " bench [min_n [max_n [max_edges]]] [options]" << endl;
+			cerr << "Generates every method at three density levels for n = min_n, 10 min_n, ... up to max_n (default: " << BENCHMARK_MIN_N << ", "
+				<< BENCHMARK_MAX_N << "), skipping the sizes predicted to exceed max_edges (default: " << BENCHMARK_MAX_EDGES << ")" << endl;
+			exit(EXIT_FAILURE);
+		}
+		runBenchmark(argc > 2 ? stoi(argv[2]) : BENCHMARK_MIN_N, argc > 3 ? stoi(argv[3]) : BENCHMARK_MAX_N, argc > 4 ? stoll(argv[4]) : BENCHMARK_MAX_EDGES);
+		return 0;
+	}
+	if (argc > 1 && string(argv[1]) == "batch") {
+		readOptions(argc, argv);
+		if (argc != 3) {
+			cerr << "Usage: " << argv[0] << " batch manifest_file [--threads number_of_threads] [options]" << endl;
+			cerr << "Every line of the manifest: chordal_gen_method number_of_vertices method_specific_param(s) first_index[-last_index]" << endl;
+			exit(EXIT_FAILURE);
+		}
+		return generateBatch(argv[2]) == 0 ? 0 : EXIT_FAILURE;
+	}
+
+	cout << "Starting to read arguments..." << endl;
+	ChordalGenerationParams params = readArguments(argc, argv);
+	cout << "Finished reading arguments (seed: " << seed << ")..." << endl;
+	
+	ChordalGraph* pchg;
+	pchg = new ChordalGraph(params);
+	if (estimateOnly) {
+		estimateInstance(*pchg, params._numNodes);
+		delete pchg;
+		return 0;
+	}
+	string outDirMethod;
+	string fileNameBase = makeInstanceDirectories(params._method, n, graphIndex, outDirMethod);
+	string fileName = buildAndWriteGraph(*pchg, fileNameBase);
+	if (fileName.empty())
+		exit(EXIT_FAILURE);
+
+	// Write instance stats to file
+	string instanceInfoFileName = outDirMethod;
+	instanceInfoFileName = instanceInfoFileName + DIRECTORY_SEPARATOR + INSTANCE_INFO_FILE_NAME;
+	string cliqueSizeInfoFileName = outDirMethod;
+	cliqueSizeInfoFileName = cliqueSizeInfoFileName + DIRECTORY_SEPARATOR + CLIQUE_SIZE_INFO_FILE_NAME;
+	bool isChordal = true;
+	pchg->CollectAndWriteStats(fileName, instanceInfoFileName, cliqueSizeInfoFileName, writeCliqueTree ? fileNameBase + ".td" : "",
+		verifyChordality ? &isChordal : NULL);
+
+	delete pchg; 
+
+	return isChordal ? 0 : EXIT_FAILURE;
+
+}
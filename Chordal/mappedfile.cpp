@@ -0,0 +1,70 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+MappedFile::MappedFile() : _data(NULL), _size(0) {
+#ifdef _WIN32
+	_fileHandle = INVALID_HANDLE_VALUE;
+	_mappingHandle = NULL;
+#endif
+}
+
+bool MappedFile::Open(string fileName) {
+	Close();
+#ifdef _WIN32
+	HANDLE fileHandle = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	LARGE_INTEGER fileSize;
+	if (fileHandle == INVALID_HANDLE_VALUE || !GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+		if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+		cout << "Cannot open " << fileName << "!" << endl;
+		return false;
+	}
+	_fileHandle = fileHandle;
+	_size = (size_t) fileSize.QuadPart;
+	_mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (_mappingHandle != NULL)
+		_data = (const char*) MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+	int fd = open(fileName.c_str(), O_RDONLY);
+	struct stat fileStat;
+	if (fd < 0 || fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		if (fd >= 0) close(fd);
+		cout << "Cannot open " << fileName << "!" << endl;
+		return false;
+	}
+	_size = (size_t) fileStat.st_size;
+	void* data = mmap(NULL, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd); //the mapping keeps the file open
+	if (data != MAP_FAILED) {
+		_data = (const char*) data;
+		madvise(data, _size, MADV_SEQUENTIAL);
+	}
+#endif
+	if (_data == NULL) {
+		cout << "Cannot map " << fileName << " into memory!" << endl;
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::Close() {
+#ifdef _WIN32
+	if (_data != NULL) UnmapViewOfFile(_data);
+	if (_mappingHandle != NULL) CloseHandle(_mappingHandle);
+	if (_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(_fileHandle);
+	_mappingHandle = NULL;
+	_fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (_data != NULL) munmap((void*) _data, _size);
+#endif
+	_data = NULL;
+	_size = 0;
+}
@@ -0,0 +1,29 @@
+#ifndef MAPPEDFILE_H_
+#define MAPPEDFILE_H_
+
+#include "common.h"
+
+/*
+ * a whole file mapped read-only into memory (mmap, or MapViewOfFile on Windows)
+ */
+class MappedFile {
+public:
+	MappedFile();
+	~MappedFile() { Close(); }
+	bool Open(string fileName);
+	void Close();
+	const char* GetData() const { return _data; }
+	size_t GetSize() const { return _size; }
+
+private:
+	const char* _data;
+	size_t _size;
+#ifdef _WIN32
+	void* _fileHandle;
+	void* _mappingHandle;
+#endif
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+};
+
+#endif
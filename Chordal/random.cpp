@@ -0,0 +1,103 @@
+#include "random.h"
+
+static uint64_t SplitMix64(uint64_t& x) {
+	uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+#define POISSON_PTRS_MIN_MEAN 10
+
+/*
+ * log(k!) from a table below 10 and from the Stirling series of Hoermann's PTRS above (error below 1e-8), instead of lgamma,
+ * which writes the global signgam and so is not safe to call from the worker threads of the batch mode
+ */
+static double LogFactorial(long long k) {
+	static const double table[10] = {0.0, 0.0, 0.693147180559945, 1.791759469228055, 3.178053830347945, 4.787491742782046,
+		6.579251212010101, 8.525161361065415, 10.604602902745251, 12.801827480081469};
+	if (k < 10) return table[k];
+	double k1 = k + 1.0;
+	return (k + 0.5) * log(k1) - k1 + 0.918938533204672742 + (1.0 / 12 - 1 / (360 * k1 * k1)) / k1; //0.9189... = log(sqrt(2 pi))
+}
+
+/*
+ * the stream key is mixed into the seed before SplitMix64 expands it, so nearby seeds and keys still give unrelated states
+ */
+void RandomEngine::Seed(uint64_t seed, uint64_t stream) {
+	uint64_t x = seed;
+	x = SplitMix64(x) ^ stream;
+	for (int lane = 0; lane < RANDOM_LANES; ++lane) {
+		for (int i = 0; i < 4; ++i)
+			_state[i][lane] = SplitMix64(x);
+	}
+	_next = RANDOM_BLOCK_SIZE;
+}
+
+void RandomEngine::Refill() {
+	for (int k = 0; k < RANDOM_BLOCK_SIZE; k += RANDOM_LANES) {
+		for (int lane = 0; lane < RANDOM_LANES; ++lane) {
+			uint64_t s1 = _state[1][lane];
+			uint64_t x = s1 * 5;
+			_block[k + lane] = ((x << 7) | (x >> 57)) * 9;
+			uint64_t t = s1 << 17;
+			_state[2][lane] ^= _state[0][lane];
+			_state[3][lane] ^= s1;
+			_state[1][lane] ^= _state[2][lane];
+			_state[0][lane] ^= _state[3][lane];
+			_state[2][lane] ^= t;
+			_state[3][lane] = (_state[3][lane] << 45) | (_state[3][lane] >> 19);
+		}
+	}
+	_next = 0;
+}
+
+PoissonSampler::PoissonSampler(double mean) {
+	_mean = mean;
+	_expMinusMean = exp(-mean);
+	double sqrtMean = sqrt(mean);
+	_logMean = log(mean);
+	_b = 0.931 + 2.53 * sqrtMean;
+	_a = -0.059 + 0.02483 * _b;
+	_invAlpha = 1.1239 + 1.1328 / (_b - 3.4);
+	_vr = 0.9277 - 3.6224 / (_b - 2);
+}
+
+int PoissonSampler::Sample(RandomEngine& rng) const {
+	if (_mean < POISSON_PTRS_MIN_MEAN) {
+		int k = 0;
+		double product = rng.NextDouble();
+		while (product > _expMinusMean) {
+			k++;
+			product *= rng.NextDouble();
+		}
+		return k;
+	}
+	while (true) {
+		double u = rng.NextDouble() - 0.5;
+		double v = rng.NextDouble();
+		double us = 0.5 - fabs(u);
+		long long k = (long long) floor((2 * _a / us + _b) * u + _mean + 0.43);
+		if (us >= 0.07 && v <= _vr) return (int) k;                       //squeeze
+		if (k < 0 || (us < 0.013 && v > us)) continue;
+		if (log(v) + log(_invAlpha) - log(_a / (us * us) + _b) <= -_mean + k * _logMean - LogFactorial(k))
+			return (int) k;
+	}
+}
+
+/*
+ * FNV-1a, e.g. of the arguments of an instance
+ */
+uint64_t HashStreamKey(string key) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (size_t i = 0; i < key.size(); ++i) {
+		hash ^= (unsigned char) key[i];
+		hash *= 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+uint64_t SeedFromDevice() {
+	random_device device;
+	return (uint64_t(device()) << 32) ^ device();
+}
@@ -0,0 +1,73 @@
+#ifndef RANDOM_H_
+#define RANDOM_H_
+
+#include "common.h"
+#include <stdint.h>
+
+#define RANDOM_LANES 4              //independent xoshiro256** generators stepped together (one 256-bit vector per state word)
+#define RANDOM_BLOCK_SIZE 64        //outputs produced per refill, a multiple of RANDOM_LANES
+
+/*
+ * xoshiro256** of Blackman and Vigna in RANDOM_LANES interleaved lanes: the outputs are produced a block at a time by a loop over
+ * the lanes without dependencies between them, so the compiler can keep each state word of all lanes in one vector register;
+ * usable with the distributions of <random>. The states are filled by SplitMix64 from a seed and a stream key, so every instance
+ * draws from its own stream, which does not depend on the thread it runs on or on the other instances
+ */
+class RandomEngine {
+public:
+	typedef uint64_t result_type;
+	RandomEngine(uint64_t seed = 0, uint64_t stream = 0) { Seed(seed, stream); }
+	void Seed(uint64_t seed, uint64_t stream);
+	static constexpr result_type min() { return 0; }
+	static constexpr result_type max() { return UINT64_MAX; }
+	result_type operator()() {
+		if (_next == RANDOM_BLOCK_SIZE) Refill();
+		return _block[_next++];
+	}
+	double NextDouble() { return double(operator()() >> 11) * (1.0 / 9007199254740992.0); } //uniform in [0,1) with 53 bits
+
+	/*
+	 * uniform in [0, range) for 0 < range < 2^32, by Lemire's multiply-and-shift; the modulo is only computed when the low half
+	 * of the product falls below range, which has probability range/2^32
+	 */
+	uint32_t Below(uint32_t range) {
+		uint64_t product = (operator()() >> 32) * range;
+		uint32_t low = (uint32_t) product;
+		if (low < range) {
+			uint32_t threshold = (0u - range) % range;
+			while (low < threshold) {
+				product = (operator()() >> 32) * range;
+				low = (uint32_t) product;
+			}
+		}
+		return (uint32_t) (product >> 32);
+	}
+	int UniformInt(int first, int last) { return first + (int) Below((uint32_t) (last - first) + 1); } //uniform in [first, last]
+
+private:
+	uint64_t _state[4][RANDOM_LANES];
+	uint64_t _block[RANDOM_BLOCK_SIZE];
+	int _next;
+	void Refill();
+};
+
+/*
+ * Poisson variates for a fixed mean: the multiplication method below POISSON_PTRS_MIN_MEAN, and above it the transformed rejection
+ * with squeeze (PTRS) of Hoermann (1993), which takes about 1.1 pairs of uniforms per variate whatever the mean
+ */
+class PoissonSampler {
+public:
+	PoissonSampler(double mean);
+	int Sample(RandomEngine& rng) const;
+
+private:
+	double _mean;
+	double _expMinusMean;                   //multiplication method
+	double _logMean, _a, _b, _invAlpha, _vr; //PTRS
+};
+
+uint64_t HashStreamKey(string key);
+
+uint64_t SeedFromDevice();
+
+#endif
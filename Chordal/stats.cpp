@@ -1,113 +1,308 @@
-#include "stats.h"
-
-Stats::Stats(ChordalGraph& chg) {
-	_pchg = &chg;
-	const Graph& g = _pchg->GetGraph();
-	_numNodes = countNodes(g);
-	_numEdges = countEdges(g);
-	_density = double(_numEdges) / (_numNodes*(_numNodes - 1) / 2);
-	_numConnComps = countConnectedComponents(g);
-	_maximalCliques.reserve(_numNodes);
-	_stdev = _avgSize = _minSize = _maxSize = _numMaximalCliques = 0;
-}
-
-
-void Stats::CalculateStats() {
-	ModifiedMCS();
-	CalculateStatsOfMaximalCliques();
-	CalculateCliqueSizeFrequencies();
-}
-
-/*
- * Maximum Cardinality Search method for chordal graphs
- */
-void Stats::ModifiedMCS() {
-	const Graph& g = _pchg->GetGraph();
-	_maximalCliques.clear();
-	vector<MCSNode> nodes;
-	nodes.resize(_numNodes);
-	vector<list<int>> unlabeledNodes;
-	unlabeledNodes.resize(_numNodes);
-
-	for (int i = 0; i < _numNodes; ++i) {
-		unlabeledNodes.at(0).push_back(i); //initially all vertices are unlabeled (so their neighbours are unlabelled too)
-	}
-	list<int>::iterator it = unlabeledNodes.at(0).begin();
-	for (int i = 0; i < _numNodes; ++i) {
-		nodes.at(i)._location = it; //initial positions of unlabeled nodes
-		++it;
-		nodes.at(i)._label = -1;
-		nodes.at(i)._unlabeledIndex = 0;
-		nodes.at(i)._numLabeledNeighbours = 0;
-	}
-	int prevCard = 0, s = -1;
-	int index = 0; //this will give the index of unlabeled nodes with maximum number of labeled neighbours
-	for (int i = _numNodes - 1; i >= 0; --i) {
-		int currentNodeID = unlabeledNodes.at(index).front(); // an unlabeled vertex with maximum number of labeled neighbours
-		unlabeledNodes.at(index).pop_front(); //erase the selected node
-		while (unlabeledNodes.at(index).size() < 0.5 && index > 0.5)
-			index--;
-		nodes.at(currentNodeID)._label = i;
-		//update labels, indices, locations, and the number of labeled neighbours of each vertex
-		Node currentNode = g.nodeFromId(currentNodeID);
-		for (IncEdgeIt e(g, currentNode); e != INVALID; ++e) {
-			int neighbourID = g.id(g.runningNode(e));
-			if (nodes.at(neighbourID)._label < -0.5) { //if that neighbour is unlabeled
-				nodes.at(neighbourID)._numLabeledNeighbours++;
-				unlabeledNodes.at(nodes.at(neighbourID)._unlabeledIndex).erase(nodes.at(neighbourID)._location); //delete that node from that row 
-				nodes.at(neighbourID)._unlabeledIndex++;
-				if (nodes.at(neighbourID)._unlabeledIndex > index) index = nodes.at(neighbourID)._unlabeledIndex;
-				list<int>::iterator it = unlabeledNodes.at(nodes.at(neighbourID)._unlabeledIndex).insert(unlabeledNodes.at(nodes.at(neighbourID)._unlabeledIndex).end(), neighbourID);
-				nodes.at(neighbourID)._location = it;
-			}
-		}
-		int newCard = nodes.at(currentNodeID)._numLabeledNeighbours;
-		if (newCard <= prevCard) { //begin new clique
-			s++;
-			_maximalCliques.resize(s + 1);
-			Node currentNode = g.nodeFromId(currentNodeID);
-			for (IncEdgeIt e(g, currentNode); e != INVALID; ++e) {
-				int nodeID = g.id(g.runningNode(e));
-				if (nodes.at(nodeID)._label > -0.5) _maximalCliques.at(s).push_back(nodeID);
-			}
-			if (newCard != 0) {
-				int minLabel = _numNodes + 1;
-				for (unsigned int i = 0; i < _maximalCliques.at(s).size(); ++i) {
-					if (nodes.at(_maximalCliques.at(s).at(i))._label < minLabel) {
-						minLabel = nodes.at(_maximalCliques.at(s).at(i))._label;
-					}
-				}
-			}
-		}
-		nodes.at(currentNodeID)._cliqueID = s;
-		_maximalCliques.at(s).push_back(currentNodeID);
-		prevCard = newCard;
-	}
-}
-
-void Stats::CalculateCliqueSizeFrequencies() {
-	for (unsigned int i = 0; i < _maximalCliques.size(); ++i) {
-		unsigned int cliqueSize = _maximalCliques.at(i).size();
-		if (_sizeFrequenciesOfMaximalCliques.size() < cliqueSize + 1) {
-			// so that subtreeSize^th entry is guaranteed to exist (resize equates the newly added entries to zero)
-			_sizeFrequenciesOfMaximalCliques.resize(cliqueSize + 1);
-		}
-		_sizeFrequenciesOfMaximalCliques.at(cliqueSize)++;
-	}
-}
-
-void Stats::CalculateStatsOfMaximalCliques() {
-	_maxSize = 0;
-	_minSize = 9999999;
-	_numMaximalCliques = _maximalCliques.size();
-	_avgSize = 0;
-	long long int sumSquaredSizes = 0;
-	for (int i = 0; i < _numMaximalCliques; ++i) {
-		int size = _maximalCliques.at(i).size();
-		_avgSize += size;
-		sumSquaredSizes += size*size;
-		if (_maxSize < size) _maxSize = size;
-		if (_minSize > size) _minSize = size;
-	}
-	_avgSize = double(_avgSize) / _numMaximalCliques;
-}
+#include "stats.h"
+#include "tree.h"
+#include <limits.h>
+
+Stats::Stats(ChordalGraph& chg) : Stats(chg.GetGraph()) {}
+
+Stats::Stats(const CSRGraph& g) {
+	_pg = &g;
+	_numNodes = g.GetNumNodes();
+	_numEdges = g.GetNumEdges();
+	_density = double(_numEdges) / (double(_numNodes)*(_numNodes - 1) / 2);
+	_numConnComps = g.CountConnectedComponents();
+	_stdev = _avgSize = _minSize = _maxSize = _numMaximalCliques = 0;
+	_hasCliqueStats = false;
+}
+
+/*
+ * statistics of a graph whose edges were only streamed; the clique statistics cannot be calculated
+ */
+Stats::Stats(const CountingSink& counts) {
+	_pg = NULL;
+	_numNodes = counts.GetNumNodes();
+	_numEdges = counts.GetNumEdges();
+	_density = double(_numEdges) / (double(_numNodes)*(_numNodes - 1) / 2);
+	_numConnComps = counts.GetNumConnComps();
+	_stdev = _avgSize = _minSize = _maxSize = _numMaximalCliques = 0;
+	_hasCliqueStats = false;
+}
+
+/*
+ * statistics of a subtree intersection graph from its model: the components and the maximal cliques come from the host tree and
+ * the subtrees (see Tree::FindMaximalCliqueSizes), so the edges are not needed, only their number
+ */
+Stats::Stats(const Tree& model, long long numEdges) {
+	_pg = NULL;
+	_numNodes = model._subtreesS.Size();
+	_numEdges = numEdges;
+	_density = double(_numEdges) / (double(_numNodes)*(_numNodes - 1) / 2);
+	_numConnComps = model.CountIntersectionComponents();
+	vector<int> cliqueSizes, separatorSizes;
+	model.FindMaximalCliqueSizes(cliqueSizes, separatorSizes);
+	BeginCliqueStats();
+	for (unsigned int i = 0; i < cliqueSizes.size(); ++i)
+		AddMaximalClique(cliqueSizes[i]);
+	for (unsigned int i = 0; i < separatorSizes.size(); ++i)
+		AddSeparator(separatorSizes[i]);
+	EndCliqueStats();
+}
+
+/*
+ * the clique statistics are accumulated while MCS finds the maximal cliques; their members and the clique tree are only kept if
+ * keepCliques is set
+ */
+void Stats::CalculateStats(bool keepCliques) {
+	BeginCliqueStats();
+	ModifiedMCS(keepCliques);
+	EndCliqueStats();
+}
+
+/*
+ * the method name and its params as they appear in instance_info.csv; a params vector shorter than the method needs leaves
+ * the remaining columns empty (e.g. for graphs read back from .lgf files)
+ */
+string Stats::MethodColumns(string method, const vector<double>& params) {
+	ostringstream columns;
+	int numParams = 1;
+	if (method == "gs") {
+		columns << "growingSubtree";
+	} else if (method == "cn") {
+		columns << "connectingNodes";
+	} else if (method == "pt") {
+		columns << "prunedTree";
+		numParams = 2;
+	} else if (method == "peo") {
+		columns << "peoBased";
+	}
+	for (int i = 0; i < numParams; ++i) {
+		columns << ",";
+		if (i < (int) params.size()) columns << params[i];
+	}
+	return columns.str();
+}
+
+/*
+ * one row of instance_info.csv; the clique columns are left empty if the clique statistics were not calculated, and the row ends
+ * with the given time columns (the time to build, the times of the phases and the peak memory, see PhaseTimes)
+ */
+void Stats::WriteInstanceInfo(ostream& file, string fileName, string methodColumns, string timeColumns) const {
+	file << fileName << "," << methodColumns << ",";
+	file << _numNodes << "," << _density << "," << _numEdges << "," << _numConnComps << ",";
+	if (_hasCliqueStats) {
+		file << _numMaximalCliques << "," << _maxSize << "," << _minSize << "," << GetAvgSize() << "," << _stdev << ",";
+		file << GetTreewidth() << "," << _maxSeparatorSize << "," << _avgSeparatorSize << ",";
+	} else {
+		file << ",,,,,,,,";
+	}
+	file << timeColumns << endl;
+}
+
+/*
+ * one row of clique_size_frequencies.csv
+ */
+void Stats::WriteCliqueSizeFrequencies(ostream& file, string fileName) const {
+	file << fileName << ",";
+	for (unsigned int i = 1; i < _sizeFrequenciesOfMaximalCliques.size(); ++i) //0th entry is not needed because the indices correspond to clique sizes
+		file << _sizeFrequenciesOfMaximalCliques.at(i) << ",";
+	file << endl;
+}
+
+/*
+ * the clique tree in the tree decomposition format of PACE (.td, nodes and bags numbered from 1): bag i is the i-th maximal clique
+ * found by MCS and is joined to its parent; the clique trees of the components are joined by empty separators into one tree
+ */
+bool Stats::WriteCliqueTree(string fileName) const {
+	ofstream file(fileName);
+	if (!file) {
+		cout << "Cannot open " << fileName << " for writing!" << endl;
+		return false;
+	}
+	int numCliques = _maximalCliques.size();
+	file << "c clique tree, every edge is preceded by the size of its separator" << endl;
+	file << "s td " << numCliques << " " << _maxSize << " " << _numNodes << endl;
+	for (int i = 0; i < numCliques; ++i) {
+		file << "b " << i + 1;
+		for (unsigned int k = 0; k < _maximalCliques[i].size(); ++k)
+			file << " " << _maximalCliques[i][k] + 1;
+		file << endl;
+	}
+	for (int i = 1; i < numCliques; ++i) {
+		if (_cliqueParents[i] >= 0) {
+			file << "c separator " << _separatorSizes[i] << endl;
+			file << i + 1 << " " << _cliqueParents[i] + 1 << endl;
+		} else {
+			file << "c separator 0" << endl;
+			file << i + 1 << " 1" << endl;
+		}
+	}
+	file.close();
+	if (!file) {
+		cout << "Cannot write " << fileName << "!" << endl;
+		return false;
+	}
+	return true;
+}
+
+/*
+ * the test of Tarjan and Yannakakis (1984) in O(n + m) time: an ordering is a perfect elimination ordering iff, for every node v, the
+ * neighbours of v after it other than the first of them, p(v), are neighbours of p(v); the nodes v are grouped by p(v), so the
+ * neighbours of each p(v) are marked once. An ordering found by MCS is a perfect elimination ordering iff the graph is chordal
+ * (CalculateStats should have been called); the result is written to report as one line
+ */
+bool Stats::VerifyPEO(ostream& report, string fileName) const {
+	const CSRGraph& g = *_pg;
+	vector<int> position(_numNodes);
+	for (int i = 0; i < _numNodes; ++i)
+		position[_peo[i]] = i;
+	vector<int> parent(_numNodes, -1), firstChild(_numNodes, -1), nextChild(_numNodes, -1);
+	for (int v = 0; v < _numNodes; ++v) {
+		for (const int* it = g.NeighboursBegin(v); it != g.NeighboursEnd(v); ++it) {
+			if (position[*it] > position[v] && (parent[v] < 0 || position[*it] < position[parent[v]])) parent[v] = *it;
+		}
+		if (parent[v] >= 0) {
+			nextChild[v] = firstChild[parent[v]];
+			firstChild[parent[v]] = v;
+		}
+	}
+	vector<int> mark(_numNodes, -1);
+	for (int p = 0; p < _numNodes; ++p) {
+		if (firstChild[p] < 0) continue;
+		for (const int* it = g.NeighboursBegin(p); it != g.NeighboursEnd(p); ++it)
+			mark[*it] = p;
+		for (int v = firstChild[p]; v >= 0; v = nextChild[v]) {
+			for (const int* it = g.NeighboursBegin(v); it != g.NeighboursEnd(v); ++it) {
+				if (position[*it] > position[v] && *it != p && mark[*it] != p) {
+					report << fileName << " is NOT chordal: nodes " << p << " and " << *it << " are not adjacent, but both are neighbours of node " << v
+						<< " after it in the elimination ordering!" << endl;
+					return false;
+				}
+			}
+		}
+	}
+	report << fileName << " is chordal, its perfect elimination ordering is verified." << endl;
+	return true;
+}
+
+/*
+ * Maximum Cardinality Search method for chordal graphs: the unlabeled nodes are kept in buckets by their number of labeled neighbours,
+ * each bucket a doubly linked list in flat arrays; a node leaves the front of the highest nonempty bucket when it is labeled and
+ * enters the back of the next bucket when one more of its neighbours is labeled. A new clique begins with the labeled neighbours
+ * of its first node, which are its separator; its parent in the clique tree is the clique of the neighbour labeled last
+ * (Blair and Peyton, 1993)
+ */
+void Stats::ModifiedMCS(bool keepCliques) {
+	const CSRGraph& g = *_pg;
+	_maximalCliques.clear();
+	_cliqueParents.clear();
+	_separatorSizes.clear();
+	_peo.assign(_numNodes, -1);
+	vector<int> cliqueOf(keepCliques ? _numNodes : 0);
+	vector<int> label(_numNodes, -1), numLabeledNeighbours(_numNodes, 0);
+	vector<int> head(_numNodes, -1), tail(_numNodes, -1), next(_numNodes), prev(_numNodes);
+	auto unlink = [&](int v, int bucket) {
+		if (prev[v] >= 0) next[prev[v]] = next[v]; else head[bucket] = next[v];
+		if (next[v] >= 0) prev[next[v]] = prev[v]; else tail[bucket] = prev[v];
+	};
+	auto append = [&](int v, int bucket) {
+		prev[v] = tail[bucket];
+		next[v] = -1;
+		if (tail[bucket] >= 0) next[tail[bucket]] = v; else head[bucket] = v;
+		tail[bucket] = v;
+	};
+	for (int i = 0; i < _numNodes; ++i)
+		append(i, 0); //initially all vertices are unlabeled (so their neighbours are unlabelled too)
+
+	int prevCard = 0, s = -1, cliqueSize = 0;
+	int index = 0; //this will give the index of unlabeled nodes with maximum number of labeled neighbours
+	for (int i = _numNodes - 1; i >= 0; --i) {
+		int currentNodeID = head[index]; // an unlabeled vertex with maximum number of labeled neighbours
+		unlink(currentNodeID, index);
+		while (head[index] < 0 && index > 0)
+			index--;
+		label[currentNodeID] = i;
+		_peo[i] = currentNodeID;
+		//update the buckets of the unlabeled neighbours
+		for (const int* it = g.NeighboursBegin(currentNodeID); it != g.NeighboursEnd(currentNodeID); ++it) {
+			int neighbourID = *it;
+			if (label[neighbourID] < 0) {
+				unlink(neighbourID, numLabeledNeighbours[neighbourID]);
+				append(neighbourID, ++numLabeledNeighbours[neighbourID]);
+				if (numLabeledNeighbours[neighbourID] > index) index = numLabeledNeighbours[neighbourID];
+			}
+		}
+		int newCard = numLabeledNeighbours[currentNodeID];
+		if (newCard <= prevCard) { //begin new clique, which consists of the labeled neighbours
+			if (s >= 0) AddMaximalClique(cliqueSize);
+			if (newCard > 0) AddSeparator(newCard);
+			s++;
+			cliqueSize = newCard;
+			if (keepCliques) {
+				_maximalCliques.resize(s + 1);
+				int lastLabeled = -1;
+				for (const int* it = g.NeighboursBegin(currentNodeID); it != g.NeighboursEnd(currentNodeID); ++it) {
+					if (label[*it] >= 0) {
+						_maximalCliques[s].push_back(*it);
+						if (lastLabeled < 0 || label[*it] < label[lastLabeled]) lastLabeled = *it;
+					}
+				}
+				_cliqueParents.push_back(lastLabeled >= 0 ? cliqueOf[lastLabeled] : -1);
+				_separatorSizes.push_back(newCard);
+			}
+		}
+		cliqueSize++;
+		if (keepCliques) {
+			_maximalCliques[s].push_back(currentNodeID);
+			cliqueOf[currentNodeID] = s;
+		}
+		prevCard = newCard;
+	}
+	if (s >= 0) AddMaximalClique(cliqueSize);
+}
+
+void Stats::BeginCliqueStats() {
+	_numMaximalCliques = 0;
+	_maxSize = 0;
+	_minSize = INT_MAX;
+	_sumSizes = _sumSquaredSizes = 0;
+	_sizeFrequenciesOfMaximalCliques.clear();
+	_numSeparators = _maxSeparatorSize = 0;
+	_sumSeparatorSizes = 0;
+}
+
+void Stats::AddMaximalClique(int size) {
+	_numMaximalCliques++;
+	_sumSizes += size;
+	_sumSquaredSizes += (long long) size*size;
+	if (_maxSize < size) _maxSize = size;
+	if (_minSize > size) _minSize = size;
+	if ((int) _sizeFrequenciesOfMaximalCliques.size() < size + 1) {
+		// so that size^th entry is guaranteed to exist (resize equates the newly added entries to zero)
+		_sizeFrequenciesOfMaximalCliques.resize(size + 1);
+	}
+	_sizeFrequenciesOfMaximalCliques[size]++;
+}
+
+/*
+ * a nonempty separator, i.e. an edge of the clique tree of a component
+ */
+void Stats::AddSeparator(int size) {
+	_numSeparators++;
+	_sumSeparatorSizes += size;
+	if (_maxSeparatorSize < size) _maxSeparatorSize = size;
+}
+
+/*
+ * the mean and the (population) standard deviation of the clique sizes from their sum and the sum of their squares
+ */
+void Stats::EndCliqueStats() {
+	if (_numMaximalCliques == 0) {
+		_minSize = 0;
+		_avgSize = _stdev = 0;
+	} else {
+		_avgSize = double(_sumSizes) / _numMaximalCliques;
+		double variance = double(_sumSquaredSizes) / _numMaximalCliques - _avgSize*_avgSize;
+		_stdev = variance > 0 ? sqrt(variance) : 0;
+	}
+	_avgSeparatorSize = _numSeparators > 0 ? double(_sumSeparatorSizes) / _numSeparators : 0;
+	_hasCliqueStats = true;
+}
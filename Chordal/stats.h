@@ -1,48 +1,64 @@
-#ifndef STATS_
-#define STATS_
-
-#include "chordal.h"
-
-class MCSNode {
-public:
-	int _label, _numLabeledNeighbours;
-	list<int>::iterator _location;
-	int _unlabeledIndex;
-	int _cliqueID;
-};
-
-class Stats {
-public:
-	Stats(ChordalGraph& chg);
-	int GetNumNodes() const { return _numNodes; };
-	int GetNumEdges() const { return _numEdges; };
-	int GetNumConnComps() const { return _numConnComps; };
-	int GetNumMaximalCliques() const { return _numMaximalCliques; };
-	int GetMaxSize() const { return _maxSize; };
-	int GetMinSize() const { return _minSize; };
-	int GetAvgSize() const { return _avgSize; };
-	double GetStdev() const { return _stdev; };
-	double GetDensity() const { return _density; };
-	const vector<int>& GetCliqueSizeFreqs() const { return _sizeFrequenciesOfMaximalCliques; }
-
-	void CalculateStats();
-
-private:
-	ChordalGraph* _pchg;
-	int _numNodes, _numEdges;
-	double _density; //edge density of the graph
-
-	int _numMaximalCliques, _numConnComps;
-	int _maxSize, _minSize;
-	double _avgSize, _stdev;
-
-	vector<vector<int>> _maximalCliques;
-	vector<int> _peo;
-	vector<int> _sizeFrequenciesOfMaximalCliques;
-
-	void ModifiedMCS();
-	void CalculateCliqueSizeFrequencies();
-	void CalculateStatsOfMaximalCliques();
-};
-
-#endif // !STATS_
+#ifndef STATS_
+#define STATS_
+
+#include "chordal.h"
+
+class Stats {
+public:
+	Stats(ChordalGraph& chg);
+	Stats(const CSRGraph& g);
+	Stats(const CountingSink& counts);
+	Stats(const Tree& model, long long numEdges);
+	int GetNumNodes() const { return _numNodes; };
+	long long GetNumEdges() const { return _numEdges; };
+	int GetNumConnComps() const { return _numConnComps; };
+	int GetNumMaximalCliques() const { return _numMaximalCliques; };
+	int GetMaxSize() const { return _maxSize; };
+	int GetMinSize() const { return _minSize; };
+	double GetAvgSize() const { return _avgSize; };
+	double GetStdev() const { return _stdev; };
+	int GetTreewidth() const { return _maxSize - 1; };
+	int GetMaxSeparatorSize() const { return _maxSeparatorSize; };
+	double GetAvgSeparatorSize() const { return _avgSeparatorSize; };
+	double GetDensity() const { return _density; };
+	const vector<int>& GetCliqueSizeFreqs() const { return _sizeFrequenciesOfMaximalCliques; }
+	bool HasCliqueStats() const { return _hasCliqueStats; }
+	const vector<int>& GetPEO() const { return _peo; }
+	const vector<vector<int>>& GetMaximalCliques() const { return _maximalCliques; } //empty unless CalculateStats(true) was called
+	const vector<int>& GetCliqueParents() const { return _cliqueParents; }            //-1 for the first clique of a component
+
+	void CalculateStats(bool keepCliques = false);
+	static string MethodColumns(string method, const vector<double>& params);
+	void WriteInstanceInfo(ostream& file, string fileName, string methodColumns, string timeColumns) const;
+	void WriteCliqueSizeFrequencies(ostream& file, string fileName) const;
+	bool WriteCliqueTree(string fileName) const;
+	bool VerifyPEO(ostream& report, string fileName) const;
+
+private:
+	const CSRGraph* _pg;
+	int _numNodes;
+	long long _numEdges;
+	bool _hasCliqueStats;
+	double _density; //edge density of the graph
+
+	int _numMaximalCliques, _numConnComps;
+	int _maxSize, _minSize;
+	double _avgSize, _stdev;
+	long long _sumSizes, _sumSquaredSizes;
+	int _numSeparators, _maxSeparatorSize;
+	long long _sumSeparatorSizes;
+	double _avgSeparatorSize;
+
+	vector<vector<int>> _maximalCliques;
+	vector<int> _cliqueParents, _separatorSizes; //clique tree: the parent of each clique and the size of its separator
+	vector<int> _peo;               //perfect elimination ordering found by ModifiedMCS: _peo[0] is eliminated first
+	vector<int> _sizeFrequenciesOfMaximalCliques;
+
+	void ModifiedMCS(bool keepCliques);
+	void BeginCliqueStats();
+	void AddMaximalClique(int size);
+	void AddSeparator(int size);
+	void EndCliqueStats();
+};
+
+#endif // !STATS_
@@ -0,0 +1,64 @@
+#include "timing.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+void PhaseTimes::Reset() {
+	for (int phase = 0; phase < NUM_PHASES; ++phase) {
+		_seconds[phase] = 0;
+		_measured[phase] = false;
+	}
+}
+
+/*
+ * the phase columns of instance_info.csv, empty for the phases that did not take place, and the peak resident set size of the
+ * process so far in MB (of all instances running at once in batch mode)
+ */
+string PhaseTimes::Columns() const {
+	ostringstream columns;
+	for (int phase = 0; phase < NUM_PHASES; ++phase) {
+		if (_measured[phase]) columns << _seconds[phase];
+		columns << ",";
+	}
+	long long peakRSS = GetPeakRSS();
+	if (peakRSS > 0) columns << double(peakRSS) / (1 << 20);
+	return columns.str();
+}
+
+/*
+ * in bytes, 0 if unknown; on Linux the high water mark of /proc/self/status, which (unlike getrusage) can be reset by writing 5 to
+ * /proc/self/clear_refs
+ */
+long long GetPeakRSS() {
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (long long) counters.PeakWorkingSetSize;
+	return 0;
+#else
+	ifstream status("/proc/self/status");
+	string line;
+	while (getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0)
+			return stoll(line.substr(6)) * 1024; //in kB
+	}
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return (long long) usage.ru_maxrss * 1024; //in kB on Linux
+	return 0;
+#endif
+}
+
+/*
+ * so that GetPeakRSS measures from now on; only possible on Linux
+ */
+void ResetPeakRSS() {
+#ifndef _WIN32
+	ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5" << endl;
+#endif
+}
@@ -0,0 +1,58 @@
+#ifndef TIMING_H_
+#define TIMING_H_
+
+#include "common.h"
+#include <chrono>
+
+typedef chrono::steady_clock::time_point TimePoint;
+
+/*
+ * phases of an instance, in the order of their columns in instance_info.csv
+ */
+enum Phase {
+	PHASE_HOST_TREE,            //BuildRandomTree of gs, cn and pt
+	PHASE_SUBTREES,             //the FindAndAdd* loop of gs, cn and pt
+	PHASE_EDGES,                //ConstructIntersectionGraph of gs, cn and pt, or the whole construction of peo
+	PHASE_WRITE,                //writing the graph file(s), unless the edges are streamed (they are written in PHASE_EDGES then)
+	PHASE_STATS,                //the statistics, including the clique tree and the verification
+	NUM_PHASES
+};
+
+/*
+ * wall-clock (steady clock) seconds spent in each phase, which stay meaningful when the phase or other instances run in parallel
+ */
+class PhaseTimes {
+public:
+	PhaseTimes() { Reset(); }
+	void Reset();
+	void Add(Phase phase, double seconds) { _seconds[phase] += seconds; _measured[phase] = true; }
+	double Get(Phase phase) const { return _seconds[phase]; }
+	string Columns() const;
+
+private:
+	double _seconds[NUM_PHASES];
+	bool _measured[NUM_PHASES];
+};
+
+/*
+ * adds the time from its construction to its destruction to a phase
+ */
+class ScopedTimer {
+public:
+	ScopedTimer(PhaseTimes& times, Phase phase) : _times(times), _phase(phase), _begin(chrono::steady_clock::now()) {}
+	~ScopedTimer() { _times.Add(_phase, SecondsSince(_begin)); }
+	static double SecondsSince(TimePoint begin) { return chrono::duration<double>(chrono::steady_clock::now() - begin).count(); }
+
+private:
+	PhaseTimes& _times;
+	Phase _phase;
+	TimePoint _begin;
+	ScopedTimer(const ScopedTimer&);
+	ScopedTimer& operator=(const ScopedTimer&);
+};
+
+long long GetPeakRSS();
+
+void ResetPeakRSS();
+
+#endif
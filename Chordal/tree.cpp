@@ -1,206 +1,370 @@
-#include "tree.h"
-
-SearchNode::SearchNode(int nodeID) {
-		_nodeID = nodeID;
-		_admissibleVectorConstructed = false;
-}
-
-void SearchNode::AddAllAdmissibleNodes(const Graph& g, vector<bool>& labels) {
-	Node n = g.nodeFromId(_nodeID);
-	for (IncEdgeIt e(g, n); e != INVALID; ++e) {
-		int candidateID = g.id(g.runningNode(e));
-		if (!labels.at(candidateID)) //if that arc is admissible
-			_admissibleNodeIDs.push_back(candidateID);
-	}
-	_admissibleVectorConstructed = true;
-}
-
-bool PairComparison(pair<int, double> p1, pair<int, double> p2) {
-	return (p1.second < p2.second);
-}
-
-bool PairComparison2(pair<int, vector<int>> p1, pair<int, vector<int>> p2) {
-	return (p1.first < p2.first);
-}
-
-void Tree::BuildRandomTree() {
-	_g.addNode();
-	for (int i = 1; i < _numNodes; ++i) {
-		uniform_int_distribution<int>  nodeSelector(0, i - 1);
-		int selectedNodeID = nodeSelector(generator); 
-		Node u = _g.nodeFromId(selectedNodeID);
-		Node v = _g.addNode();
-		_g.addEdge(u, v);
-	}
-}
-
-void Tree::SetProbsToEdges() {
-	_probVector.clear();
-	for (int i = 0; i < _numNodes - 1; ++i) {
-		_probVector.push_back(((double)rand()) / ((long) RAND_MAX+1));
-	}
-}
-
-void Tree::SetProbsToNodes() {
-	_probVector.clear();
-	for (int i = 0; i < _numNodes; ++i)	{
-		_probVector.push_back(double(rand()) / ((long) RAND_MAX + 1));
-	}
-}
-
-void Tree::ShuffleEdgeIDs(vector<int>& shuffledEdgeIDs) {
-	int numEdges = _numNodes - 1;
-	vector<pair<int, double>> edgeOrder;
-	for (int i = 0; i < numEdges; ++i) 	{
-		pair<int, double> p(i, double(rand()) / ((long) RAND_MAX + 1));
-		edgeOrder.push_back(p);
-	}
-	sort(edgeOrder.begin(), edgeOrder.end(), PairComparison);
-	for (int i = 0; i < numEdges; ++i) 	{
-		shuffledEdgeIDs.push_back(edgeOrder.at(i).first);
-	}
-}
-
-void Tree::FindNodesInRandomlySelectedConnComp(const Graph& g, set<int>& subtree, double selectionBarrier) {
-	vector<vector<Node>> connComps;
-	CompMap compMap(g);
-	int numConnComps = connectedComponents(g, compMap);
-	connComps.resize(numConnComps);
-	for (NodeIt n(g); n != INVALID; ++n)
-		connComps.at(compMap[n]).push_back(n);
-	vector<pair<int, vector<int>>> sizesAndCompIDs; //first entry of the pair is the size, and the second entry is the vector of comp IDs with that size
-	int sumOfDistinctCompSizes = 0;
-	for (unsigned int i = 0; i < connComps.size(); ++i) {
-		int index = -1;
-		for (unsigned int j = 0; j < sizesAndCompIDs.size(); ++j) {
-			if (connComps.at(i).size() == (unsigned int) sizesAndCompIDs.at(j).first) { //if that size is already encountered
-				index = j;
-				break;
-			}
-		}
-		if (index == -1) { //if no such size is encountered before
-			sizesAndCompIDs.resize(sizesAndCompIDs.size() + 1);
-			sizesAndCompIDs.back().first = connComps.at(i).size();
-			sizesAndCompIDs.back().second.push_back(i); //i is the ID of the connected component
-			sumOfDistinctCompSizes += connComps.at(i).size();
-		} else 	{
-			sizesAndCompIDs.at(index).first = connComps.at(i).size();
-			sizesAndCompIDs.at(index).second.push_back(i); //i is the ID of the connected component
-		}
-	}
-	sort(sizesAndCompIDs.begin(), sizesAndCompIDs.end(), PairComparison2); //to sort component sizes in ascending order
-	int numDifferentCompSizes = sizesAndCompIDs.size();
-	int firstIndex = floor(selectionBarrier*numDifferentCompSizes);
-	uniform_int_distribution<int>  selector(firstIndex, numDifferentCompSizes - 1);
-	int index = selector(generator);
-	uniform_int_distribution<int>  selector2(0, sizesAndCompIDs.at(index).second.size() - 1);
-	int selectedCompID = sizesAndCompIDs.at(index).second.at(selector2(generator));
-	for (unsigned int i = 0; i < connComps.at(selectedCompID).size(); ++i) {
-		subtree.insert(_numNodes - 1 - g.id(connComps.at(selectedCompID).at(i))); //since graphCopy fnc reverses node IDs, we insert the IDs like this
-	}
-}
-
-void Tree::RevealSubtreeOnSelectedNodes(const vector<int>& allNodeIDs, int separator, set<int>& subtree) {
-		if (separator > 1.1) { //if there are more than 1 node selected
-			Bfs<Graph> bfs(_g);
-			for (int i = 1; i < separator; ++i) {
-				Node currentNode = _g.nodeFromId(allNodeIDs.at(i));
-				bfs.run(_g.nodeFromId(allNodeIDs.at(0)), currentNode);
-				Node prevNode = bfs.predNode(_g.nodeFromId(allNodeIDs.at(i)));
-				subtree.insert(allNodeIDs.at(i));
-				while (prevNode != INVALID) {
-					int prevNodeID = _g.id(prevNode);
-					subtree.insert(prevNodeID);
-					currentNode = prevNode;
-					prevNode = bfs.predNode(currentNode);
-				}
-			}
-		} else {
-			subtree.insert(allNodeIDs.at(0));
-		}
-	}
-/*
- * To grow the subtree, e select a random node from it, and then randomly select an admissible neighbour of that node
- */
-void Tree::FindAndAddGrowingSubtree(int subtreeSize) {
-	set<int> subtree;
-	uniform_int_distribution<int>  selector(0, _numNodes - 1);
-	int startNodeID = selector(generator); //select a random node on tree to start with
-	subtree.insert(startNodeID);
-	if (subtreeSize > 1.5) {
-		vector<bool> labels; //false will denote unmarked
-		labels.resize(_numNodes);
-		for (int i = 0; i < _numNodes; ++i) labels.at(i) = false;
-		labels.at(startNodeID) = true;
-		vector<SearchNode> list;
-		SearchNode n(startNodeID);
-		n.AddAllAdmissibleNodes(_g, labels);
-		list.push_back(n);
-		int currentSubtreeSize = subtree.size(); //=1 now
-		int pickedIndex = 0;
-		while (currentSubtreeSize < subtreeSize) {
-			uniform_int_distribution<int>  selector2(0, list.at(pickedIndex)._admissibleNodeIDs.size() - 1);
-			int selectedAdmissibleNodeIndex = selector2(generator); 
-			int selectedAdmissibleNodeID = list.at(pickedIndex)._admissibleNodeIDs.at(selectedAdmissibleNodeIndex);
-			SearchNode n2(selectedAdmissibleNodeID);
-			list.push_back(n2);
-			//remove the selected admissible node from the admissibles list
-			list.at(pickedIndex)._admissibleNodeIDs.erase(list.at(pickedIndex)._admissibleNodeIDs.begin() + selectedAdmissibleNodeIndex);
-			labels.at(selectedAdmissibleNodeID) = true;
-			subtree.insert(selectedAdmissibleNodeID);
-			currentSubtreeSize++;
-			uniform_int_distribution<int>  selector3(0, list.size() - 1);
-			pickedIndex = selector3(generator); //pick a random node from the list
-			if (!list.at(pickedIndex)._admissibleVectorConstructed) {
-				list.at(pickedIndex).AddAllAdmissibleNodes(_g, labels);
-			}
-			int numAdmissibleNodes = list.at(pickedIndex)._admissibleNodeIDs.size();
-			while (numAdmissibleNodes == 0 && currentSubtreeSize < subtreeSize) { //pick a node from list which has an admissible node
-				list.erase(list.begin() + pickedIndex);
-				uniform_int_distribution<int>  selector4(0, list.size() - 1);
-				pickedIndex = selector4(generator); 
-				if (!list.at(pickedIndex)._admissibleVectorConstructed) {
-					list.at(pickedIndex).AddAllAdmissibleNodes(_g, labels);
-				}
-				numAdmissibleNodes = list.at(pickedIndex)._admissibleNodeIDs.size();
-			}
-		}
-	}
-	_subtreesS.push_back(subtree);
-}
-
-/*
- * this fnc will randomly select deletionPercentage of edges from the tree and delete it
- */
-void Tree::FindAndAddSubtreeWithEdgeDeletion(double deletionPercentage, double selectionBarrier) {
-	Graph s;
-	graphCopy(_g, s).run();
-	int numEdgesToDelete = deletionPercentage*(_numNodes - 1); 
-	vector<int> shuffledEdgeIDs;
-	ShuffleEdgeIDs(shuffledEdgeIDs);
-	for (int i = 0; i < numEdgesToDelete; ++i) {
-		s.erase(s.edgeFromId(shuffledEdgeIDs.at(i)));
-	}
-	set<int> subtree;
-	FindNodesInRandomlySelectedConnComp(s, subtree, selectionBarrier);
-	_subtreesS.push_back(subtree);
-}
-
-/*
- * take numNodesToConnect-many nodes and connect them with the paths that connect them on the host tree to get a subtree
- */
-void Tree::FindAndAddSubtreeByConnNodes(int numNodesToConnect, vector<int>& allNodeIDs) {
-	int separator = 0; //separator takes the value of the element that it is on the left of
-	while (separator < numNodesToConnect) {
-		uniform_int_distribution<int>  selector(separator, _numNodes - 1);
-		int selectedIndex = selector(generator);
-		//swap the elements
-		int temp = allNodeIDs.at(selectedIndex);
-		allNodeIDs.at(selectedIndex) = allNodeIDs.at(separator);
-		allNodeIDs.at(separator) = temp;
-		separator++;
-	}
-	set<int> subtree;
-	RevealSubtreeOnSelectedNodes(allNodeIDs, separator, subtree);
-	_subtreesS.push_back(subtree);
-}
+#include "tree.h"
+
+SearchNode::SearchNode(int nodeID) {
+		_nodeID = nodeID;
+		_admissibleBegin = _numAdmissible = 0;
+		_admissibleVectorConstructed = false;
+}
+
+void SubtreeList::Add(vector<int>& nodes) {
+	sort(nodes.begin(), nodes.end());
+	_nodes.insert(_nodes.end(), nodes.begin(), nodes.end());
+	_offsets.push_back(_nodes.size());
+}
+
+void Tree::BuildRandomTree() {
+	_parent.assign(1, -1);
+	_depth.assign(1, 0);
+	for (int i = 1; i < _numNodes; ++i) {
+		int selectedNodeID = (int) _rng.Below(i); 
+		_parent.push_back(selectedNodeID);
+		_depth.push_back(_depth.at(selectedNodeID) + 1);
+	}
+}
+
+/*
+ * binary lifting table; the number of levels follows the actual height, which is O(log n) for the random recursive trees built above
+ */
+void Tree::PrepareLCA() {
+	int height = *max_element(_depth.begin(), _depth.end());
+	int numLevels = 1;
+	while ((1 << numLevels) <= height) numLevels++;
+	_ancestors.resize(numLevels);
+	_ancestors.at(0) = _parent;
+	_ancestors.at(0).at(0) = 0;
+	for (int k = 1; k < numLevels; ++k) {
+		_ancestors.at(k).resize(_numNodes);
+		for (int v = 0; v < _numNodes; ++v)
+			_ancestors.at(k)[v] = _ancestors.at(k - 1)[_ancestors.at(k - 1)[v]];
+	}
+}
+
+int Tree::FindLCA(int u, int v) const {
+	if (_depth[u] < _depth[v]) swap(u, v);
+	int diff = _depth[u] - _depth[v];
+	for (int k = 0; diff > 0; ++k, diff >>= 1) {
+		if (diff & 1) u = _ancestors[k][u];
+	}
+	if (u == v) return u;
+	for (int k = _ancestors.size() - 1; k >= 0; --k) {
+		if (_ancestors[k][u] != _ancestors[k][v]) {
+			u = _ancestors[k][u];
+			v = _ancestors[k][v];
+		}
+	}
+	return _parent[u];
+}
+
+void Tree::SetProbsToEdges() {
+	_probVector.clear();
+	for (int i = 0; i < _numNodes - 1; ++i) {
+		_probVector.push_back(_rng.NextDouble());
+	}
+}
+
+void Tree::SetProbsToNodes() {
+	_probVector.clear();
+	for (int i = 0; i < _numNodes; ++i)	{
+		_probVector.push_back(_rng.NextDouble());
+	}
+}
+
+void Tree::PrepareChildren() {
+	_childOffsets.assign(_numNodes + 1, 0);
+	for (int v = 1; v < _numNodes; ++v)
+		_childOffsets[_parent[v] + 1]++;
+	for (int v = 0; v < _numNodes; ++v)
+		_childOffsets[v + 1] += _childOffsets[v];
+	_children.resize(_numNodes - 1);
+	vector<int> position(_childOffsets.begin(), _childOffsets.end() - 1);
+	for (int v = 1; v < _numNodes; ++v)
+		_children[position[_parent[v]]++] = v;
+}
+
+/*
+ * the nodes whose parent edges are stamped with _currentStamp are the roots of the components (besides node 0);
+ * since parent[v] < v, a single reverse sweep adds every component to its root, which is what a union-find over the
+ * surviving edges would do
+ */
+void Tree::FindNodesInRandomlySelectedConnComp(int numEdgesDeleted, vector<int>& subtree, double selectionBarrier) {
+	_componentSizes.assign(_numNodes, 1);
+	for (int v = _numNodes - 1; v > 0; --v) {
+		if (_stamps[v] != _currentStamp) _componentSizes[_parent[v]] += _componentSizes[v];
+	}
+	if (_sizeStamps.empty()) {
+		_sizeStamps.resize(_numNodes + 1, 0);
+		_sizeSlots.resize(_numNodes + 1);
+	}
+	_sizesAndSlots.clear();
+	for (int i = -1; i < numEdgesDeleted; ++i) {
+		int root = (i < 0) ? 0 : _edgeIDs[i] + 1;
+		int size = _componentSizes[root];
+		if (_sizeStamps[size] != _currentStamp) { //if no such size is encountered before
+			_sizeStamps[size] = _currentStamp;
+			_sizeSlots[size] = _sizesAndSlots.size();
+			_sizesAndSlots.push_back(make_pair(size, _sizeSlots[size]));
+			if (_compsBySize.size() < _sizesAndSlots.size()) _compsBySize.resize(_sizesAndSlots.size());
+			_compsBySize[_sizeSlots[size]].clear();
+		}
+		_compsBySize[_sizeSlots[size]].push_back(root);
+	}
+	sort(_sizesAndSlots.begin(), _sizesAndSlots.end()); //to sort component sizes in ascending order
+	int numDifferentCompSizes = _sizesAndSlots.size();
+	int firstIndex = floor(selectionBarrier*numDifferentCompSizes);
+	const vector<int>& roots = _compsBySize.at(_sizesAndSlots.at(_rng.UniformInt(firstIndex, numDifferentCompSizes - 1)).second);
+	int selectedRoot = roots.at(_rng.Below(roots.size()));
+	_nodeStack.assign(1, selectedRoot);
+	while (!_nodeStack.empty()) { //collect the component, without passing through deleted edges
+		int nodeID = _nodeStack.back();
+		_nodeStack.pop_back();
+		subtree.push_back(nodeID);
+		for (int k = _childOffsets[nodeID]; k < _childOffsets[nodeID + 1]; ++k) {
+			if (_stamps[_children[k]] != _currentStamp) _nodeStack.push_back(_children[k]);
+		}
+	}
+}
+
+/*
+ * the subtree spanning the selected nodes is the union of their paths up to the LCA of all of them;
+ * each path is walked only until it reaches a node that is already in the subtree, so the cost is proportional to the output
+ */
+void Tree::RevealSubtreeOnSelectedNodes(const vector<int>& allNodeIDs, int separator, vector<int>& subtree) {
+	if (_ancestors.empty()) PrepareLCA();
+	if (_stamps.empty()) _stamps.resize(_numNodes, 0);
+	_currentStamp++;
+	int lca = allNodeIDs.at(0);
+	for (int i = 1; i < separator; ++i)
+		lca = FindLCA(lca, allNodeIDs.at(i));
+	_stamps[lca] = _currentStamp;
+	subtree.push_back(lca);
+	for (int i = 0; i < separator; ++i) {
+		int nodeID = allNodeIDs.at(i);
+		while (_stamps[nodeID] != _currentStamp) {
+			_stamps[nodeID] = _currentStamp;
+			subtree.push_back(nodeID);
+			nodeID = _parent[nodeID];
+		}
+	}
+}
+void Tree::AddAllAdmissibleNodes(SearchNode& searchNode) {
+	searchNode._admissibleBegin = _admissibleBuffer.size();
+	int nodeID = searchNode._nodeID;
+	if (_parent[nodeID] >= 0 && _stamps[_parent[nodeID]] != _currentStamp) //if that arc is admissible
+		_admissibleBuffer.push_back(_parent[nodeID]);
+	for (int k = _childOffsets[nodeID]; k < _childOffsets[nodeID + 1]; ++k) {
+		if (_stamps[_children[k]] != _currentStamp)
+			_admissibleBuffer.push_back(_children[k]);
+	}
+	searchNode._numAdmissible = _admissibleBuffer.size() - searchNode._admissibleBegin;
+	searchNode._admissibleVectorConstructed = true;
+}
+
+/*
+ * To grow the subtree, e select a random node from it, and then randomly select an admissible neighbour of that node
+ * the search list, the admissible lists (ranges of one shared buffer) and the visited stamps are reused across calls, and
+ * removals swap the removed entry with the last one; the selections are uniform, so the order of the lists does not matter
+ */
+void Tree::FindAndAddGrowingSubtree(int subtreeSize) {
+	if (_childOffsets.empty()) PrepareChildren();
+	if (_stamps.empty()) _stamps.resize(_numNodes, 0);
+	subtreeSize = min(subtreeSize, _numNodes);
+	_currentStamp++;
+	_subtreeBuffer.clear();
+	int startNodeID = (int) _rng.Below(_numNodes); //select a random node on tree to start with
+	_subtreeBuffer.push_back(startNodeID);
+	if (subtreeSize > 1.5) {
+		_stamps[startNodeID] = _currentStamp;
+		_searchList.clear();
+		_admissibleBuffer.clear();
+		_searchList.push_back(SearchNode(startNodeID));
+		AddAllAdmissibleNodes(_searchList.back());
+		int currentSubtreeSize = 1;
+		int pickedIndex = 0;
+		while (currentSubtreeSize < subtreeSize) {
+			SearchNode& picked = _searchList[pickedIndex];
+			int selectedAdmissibleNodeIndex = picked._admissibleBegin + (int) _rng.Below(picked._numAdmissible);
+			int selectedAdmissibleNodeID = _admissibleBuffer[selectedAdmissibleNodeIndex];
+			//remove the selected admissible node from the admissibles list
+			_admissibleBuffer[selectedAdmissibleNodeIndex] = _admissibleBuffer[picked._admissibleBegin + picked._numAdmissible - 1];
+			picked._numAdmissible--;
+			_searchList.push_back(SearchNode(selectedAdmissibleNodeID));
+			_stamps[selectedAdmissibleNodeID] = _currentStamp;
+			_subtreeBuffer.push_back(selectedAdmissibleNodeID);
+			currentSubtreeSize++;
+			pickedIndex = (int) _rng.Below(_searchList.size()); //pick a random node from the list
+			if (!_searchList[pickedIndex]._admissibleVectorConstructed) {
+				AddAllAdmissibleNodes(_searchList[pickedIndex]);
+			}
+			while (_searchList[pickedIndex]._numAdmissible == 0 && currentSubtreeSize < subtreeSize) { //pick a node from list which has an admissible node
+				_searchList[pickedIndex] = _searchList.back();
+				_searchList.pop_back();
+				pickedIndex = (int) _rng.Below(_searchList.size()); 
+				if (!_searchList[pickedIndex]._admissibleVectorConstructed) {
+					AddAllAdmissibleNodes(_searchList[pickedIndex]);
+				}
+			}
+		}
+	}
+	_subtreesS.Add(_subtreeBuffer);
+}
+
+/*
+ * this fnc will randomly select deletionPercentage of edges from the tree and delete it
+ * the edges are drawn by a partial Fisher-Yates shuffle of _edgeIDs and deleted by stamping their child nodes, so the tree is never copied
+ */
+void Tree::FindAndAddSubtreeWithEdgeDeletion(double deletionPercentage, double selectionBarrier) {
+	int numEdges = _numNodes - 1;
+	int numEdgesToDelete = deletionPercentage*numEdges;
+	if (_childOffsets.empty()) PrepareChildren();
+	if (_stamps.empty()) _stamps.resize(_numNodes, 0);
+	if ((int) _edgeIDs.size() != numEdges) {
+		_edgeIDs.resize(numEdges);
+		iota(_edgeIDs.begin(), _edgeIDs.end(), 0);
+	}
+	_currentStamp++;
+	for (int i = 0; i < numEdgesToDelete; ++i) {
+		swap(_edgeIDs[i], _edgeIDs[_rng.UniformInt(i, numEdges - 1)]);
+		_stamps[_edgeIDs[i] + 1] = _currentStamp;
+	}
+	_subtreeBuffer.clear();
+	FindNodesInRandomlySelectedConnComp(numEdgesToDelete, _subtreeBuffer, selectionBarrier);
+	_subtreesS.Add(_subtreeBuffer);
+}
+
+/*
+ * take numNodesToConnect-many nodes and connect them with the paths that connect them on the host tree to get a subtree
+ */
+void Tree::FindAndAddSubtreeByConnNodes(int numNodesToConnect, vector<int>& allNodeIDs) {
+	int separator = 0; //separator takes the value of the element that it is on the left of
+	while (separator < numNodesToConnect) {
+		int selectedIndex = _rng.UniformInt(separator, _numNodes - 1);
+		//swap the elements
+		int temp = allNodeIDs.at(selectedIndex);
+		allNodeIDs.at(selectedIndex) = allNodeIDs.at(separator);
+		allNodeIDs.at(separator) = temp;
+		separator++;
+	}
+	_subtreeBuffer.clear();
+	RevealSubtreeOnSelectedNodes(allNodeIDs, separator, _subtreeBuffer);
+	_subtreesS.Add(_subtreeBuffer);
+}
+
+/*
+ * frees the buffers of the subtree generation, so that a tree kept as the model of its intersection graph holds only the tree
+ * and the subtrees
+ */
+void Tree::ReleaseWorkspace() {
+	vector<vector<int>>().swap(_ancestors);
+	vector<int>().swap(_stamps);
+	vector<int>().swap(_childOffsets);
+	vector<int>().swap(_children);
+	vector<int>().swap(_edgeIDs);
+	vector<int>().swap(_componentSizes);
+	vector<int>().swap(_nodeStack);
+	vector<int>().swap(_sizeStamps);
+	vector<int>().swap(_sizeSlots);
+	vector<pair<int, int>>().swap(_sizesAndSlots);
+	vector<vector<int>>().swap(_compsBySize);
+	vector<SearchNode>().swap(_searchList);
+	vector<int>().swap(_admissibleBuffer);
+	vector<int>().swap(_subtreeBuffer);
+}
+
+/*
+ * nodeCoverage[v]: the number of subtrees containing v, edgeCoverage[v]: the number of subtrees containing the edge from v to its
+ * parent, i.e. containing v without v being their top node (as the subtrees are connected)
+ */
+void Tree::CalculateCoverage(vector<int>& nodeCoverage, vector<int>& edgeCoverage) const {
+	nodeCoverage.assign(_numNodes, 0);
+	edgeCoverage.assign(_numNodes, 0);
+	for (int i = 0; i < _subtreesS.Size(); ++i) {
+		int top = _subtreesS.Front(i);
+		for (const int* it = _subtreesS.Begin(i); it != _subtreesS.End(i); ++it) {
+			nodeCoverage[*it]++;
+			edgeCoverage[*it]++;
+			if (_depth[*it] < _depth[top]) top = *it;
+		}
+		edgeCoverage[top]--;
+	}
+}
+
+/*
+ * sizes of the maximal cliques of the intersection graph of the subtrees, without the graph: by the Helly property of subtrees every
+ * maximal clique is the set K_v of the subtrees containing some node v, and K_v is maximal iff it is not a proper subset of K_u for a
+ * tree neighbour u (if K_v is inside K_w, it is inside K_u for the next node u on the path to w). With the coverage c_v = |K_v| and
+ * the coverage c_e of the edge e from v to its parent p (the subtrees containing v that do not have v as their top node),
+ * K_v is inside K_p iff c_e == c_v and K_p is inside K_v iff c_e == c_p; nodes with equal sets along tree edges form one class,
+ * represented by its top node, and a class is a maximal clique unless one of its nodes is a proper subset of a neighbour.
+ * Contracting the edges within the classes and, for every dominated class, one edge to a neighbour containing it leaves a clique
+ * tree (one per component of the graph); its separators are the subtrees containing its edges, so their sizes are the coverages
+ * of the remaining edges (a dominated class is inside the class it is contracted into, which is inside the next one, and so on)
+ */
+void Tree::FindMaximalCliqueSizes(vector<int>& cliqueSizes, vector<int>& separatorSizes) const {
+	vector<int> nodeCoverage, edgeCoverage;
+	CalculateCoverage(nodeCoverage, edgeCoverage);
+	vector<int> representative(_numNodes);
+	vector<char> dominated(_numNodes, 0);
+	representative[0] = 0;
+	separatorSizes.clear();
+	for (int v = 1; v < _numNodes; ++v) { //parents come before their children
+		int p = _parent[v];
+		bool insideParent = edgeCoverage[v] == nodeCoverage[v], containsParent = edgeCoverage[v] == nodeCoverage[p];
+		representative[v] = (insideParent && containsParent) ? representative[p] : v;
+		int inner = -1; //the class that is a proper subset of the other across the edge
+		if (insideParent && !containsParent) inner = representative[v];
+		if (containsParent && !insideParent) inner = representative[p];
+		if (inner >= 0 && !dominated[inner]) {
+			dominated[inner] = 1; //the edge is contracted
+		} else if (edgeCoverage[v] > 0 && !(insideParent && containsParent)) {
+			separatorSizes.push_back(edgeCoverage[v]);
+		}
+	}
+	cliqueSizes.clear();
+	for (int v = 0; v < _numNodes; ++v) {
+		if (representative[v] == v && !dominated[v] && nodeCoverage[v] > 0)
+			cliqueSizes.push_back(nodeCoverage[v]);
+	}
+}
+
+/*
+ * connected components of the intersection graph, without the graph: the subtrees containing the same node are joined (union-find
+ * with path halving)
+ */
+int Tree::CountIntersectionComponents() const {
+	int numSubtrees = _subtreesS.Size();
+	vector<int> components(numSubtrees), firstCovering(_numNodes, -1);
+	iota(components.begin(), components.end(), 0);
+	int numConnComps = numSubtrees;
+	for (int i = 0; i < numSubtrees; ++i) {
+		for (const int* it = _subtreesS.Begin(i); it != _subtreesS.End(i); ++it) {
+			if (firstCovering[*it] < 0) {
+				firstCovering[*it] = i;
+				continue;
+			}
+			int root1 = i, root2 = firstCovering[*it];
+			while (components[root1] != root1) root1 = components[root1] = components[components[root1]];
+			while (components[root2] != root2) root2 = components[root2] = components[components[root2]];
+			if (root1 != root2) {
+				components[max(root1, root2)] = min(root1, root2);
+				numConnComps--;
+			}
+		}
+	}
+	return numConnComps;
+}
+
+/*
+ * the number of edges of the intersection graph, without the graph: the intersection of two subtrees is a subtree, which has one
+ * more node than edges, so summing the pairs sharing a node over the nodes and subtracting the pairs sharing an edge over the edges
+ * counts every intersecting pair once
+ */
+long long Tree::CountIntersectionEdges() const {
+	vector<int> nodeCoverage, edgeCoverage;
+	CalculateCoverage(nodeCoverage, edgeCoverage);
+	long long numEdges = 0;
+	for (int v = 0; v < _numNodes; ++v) {
+		numEdges += (long long) nodeCoverage[v] * (nodeCoverage[v] - 1) / 2;
+		if (v > 0) numEdges -= (long long) edgeCoverage[v] * (edgeCoverage[v] - 1) / 2;
+	}
+	return numEdges;
+}
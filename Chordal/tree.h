@@ -1,40 +1,81 @@
-#ifndef TREE_H_
-#define TREE_H_
-
-#include "common.h"
-#include "global.h"
-
-class Tree {
-public:
-	int _numNodes;
-	Graph _g;
-	vector<Edge> _treeVector;
-	vector<double> _probVector;
-	vector<set<int>> _subtreesS;
-	Tree(int numNodes)	{ _numNodes = numNodes;	}
-	void BuildRandomTree();
-	void FindAndAddGrowingSubtree(int subtreeSize);
-	void FindAndAddSubtreeWithEdgeDeletion(double deletionPercentage, double selectionBarrier);
-	void FindAndAddSubtreeByConnNodes(int numNodesToConnect, vector<int>& allNodeIDs);
-
-private:
-	void SetProbsToEdges();
-	void SetProbsToNodes();
-	void ShuffleEdgeIDs(vector<int>& shuffledEdgeIDs);
-	void FindNodesInRandomlySelectedConnComp(const Graph& g, set<int>& subtree, double selectionBarrier);
-	void RevealSubtreeOnSelectedNodes(const vector<int>& allNodeIDs, int separator, set<int>& subtree);
-};
-
-
-class SearchNode {
-public:
-	vector<int> _admissibleNodeIDs;
-	bool _admissibleVectorConstructed;
-	SearchNode(int nodeID);
-	void AddAllAdmissibleNodes(const Graph& g, vector<bool>& labels);
-private:
-	int _nodeID;
-
-};
-
-#endif
+#ifndef TREE_H_
+#define TREE_H_
+
+#include "common.h"
+#include "random.h"
+
+/*
+ * subtrees stored back to back: the nodes of subtree i are _nodes[_offsets[i]] ... _nodes[_offsets[i+1]-1], in ascending order
+ */
+class SubtreeList {
+public:
+	SubtreeList() { _offsets.push_back(0); }
+	int Size() const { return int(_offsets.size()) - 1; }
+	int GetSize(int i) const { return int(_offsets[i + 1] - _offsets[i]); }
+	long long GetTotalSize() const { return _offsets.back(); }
+	const int* Begin(int i) const { return _nodes.data() + _offsets[i]; }
+	const int* End(int i) const { return _nodes.data() + _offsets[i + 1]; }
+	int Front(int i) const { return _nodes[_offsets[i]]; }       //the smallest node ID of subtree i
+	int Back(int i) const { return _nodes[_offsets[i + 1] - 1]; } //the largest node ID of subtree i
+	void Add(vector<int>& nodes);
+	const vector<long long>& GetOffsets() const { return _offsets; }
+	const vector<int>& GetNodes() const { return _nodes; }
+
+private:
+	vector<long long> _offsets;
+	vector<int> _nodes;
+};
+
+
+class SearchNode {
+public:
+	int _nodeID;
+	int _admissibleBegin, _numAdmissible;   //range of its admissible neighbours in the shared buffer of the tree
+	bool _admissibleVectorConstructed;
+	SearchNode(int nodeID);
+};
+
+
+class Tree {
+public:
+	int _numNodes;
+	vector<double> _probVector;
+	SubtreeList _subtreesS;
+	vector<int> _parent, _depth;     //the tree is rooted at node 0 (parent of the root is -1)
+	Tree(int numNodes, RandomEngine& rng) : _rng(rng) { _numNodes = numNodes;	_currentStamp = 0; }
+	void BuildRandomTree();
+	void FindAndAddGrowingSubtree(int subtreeSize);
+	void FindAndAddSubtreeWithEdgeDeletion(double deletionPercentage, double selectionBarrier);
+	void FindAndAddSubtreeByConnNodes(int numNodesToConnect, vector<int>& allNodeIDs);
+	void ReleaseWorkspace();
+	void FindMaximalCliqueSizes(vector<int>& cliqueSizes, vector<int>& separatorSizes) const;
+	int CountIntersectionComponents() const;
+	long long CountIntersectionEdges() const;
+
+private:
+	void SetProbsToEdges();
+	void SetProbsToNodes();
+	void PrepareChildren();
+	void AddAllAdmissibleNodes(SearchNode& searchNode);
+	void FindNodesInRandomlySelectedConnComp(int numEdgesDeleted, vector<int>& subtree, double selectionBarrier);
+	void RevealSubtreeOnSelectedNodes(const vector<int>& allNodeIDs, int separator, vector<int>& subtree);
+	void PrepareLCA();
+	int FindLCA(int u, int v) const;
+	void CalculateCoverage(vector<int>& nodeCoverage, vector<int>& edgeCoverage) const;
+
+	RandomEngine& _rng;
+	vector<vector<int>> _ancestors;  //_ancestors[k][v] is the 2^k-th ancestor of v (the root for the nodes above it)
+	vector<int> _stamps;             //_stamps[v] == _currentStamp marks v as visited in the current call, so no clearing is needed
+	int _currentStamp;
+	vector<int> _childOffsets, _children;   //children of v are _children[_childOffsets[v]] ... _children[_childOffsets[v+1]-1]
+	vector<int> _edgeIDs;                   //a permutation of the edge IDs (edge e joins node e+1 to its parent), reused by partial shuffles
+	vector<int> _componentSizes, _nodeStack;
+	vector<int> _sizeStamps, _sizeSlots;    //_sizeSlots[size] is the slot of the size in _compsBySize if _sizeStamps[size] == _currentStamp
+	vector<pair<int, int>> _sizesAndSlots;  //the sizes met in the current call with their slots, sorted by size
+	vector<vector<int>> _compsBySize;       //root nodes of the components of each size
+	vector<SearchNode> _searchList;         //growth context of FindAndAddGrowingSubtree, reused across calls
+	vector<int> _admissibleBuffer;
+	vector<int> _subtreeBuffer;             //nodes of the subtree under construction
+};
+
+#endif